@@ -0,0 +1,34 @@
+#!/bin/sh
+# Thread scaling of the stepping rate on the CODEX-b geometry
+#
+# Usage (from the build directory):
+# % sh bench/threads.sh [maxWorkers] [nEvents]
+#
+# Runs y4Project with 1 to maxWorkers worker threads (default: the number
+# of cores) on the same events, and prints the steps/s of the global run
+# and the speedup over one worker. The number of workers can only be set
+# before initialisation, hence one process per point.
+
+maxWorkers=${1:-$(nproc)}
+nEvents=${2:-100}
+y4Project=${Y4PROJECT:-./y4Project}
+macro=threads_bench.mac
+
+printf "%8s %14s %8s\n" workers steps/s speedup
+n=1
+while [ $n -le $maxWorkers ]
+do
+  cat > $macro <<END
+/run/numberOfWorkers $n
+/run/initialize
+/run/verbose 1
+/random/setSeeds 12345 67890
+/rpc/output/file threads_bench
+/run/beamOn $nEvents
+END
+  rate=$($y4Project $macro | sed -n '/End of Global Run/,$ s/.*(\([0-9.e+]*\) steps\/s).*/\1/p' | tail -1)
+  if [ $n -eq 1 ]; then single=$rate; fi
+  printf "%8d %14s %8.2f\n" $n "$rate" $(echo "$rate $single" | awk '{ print ($2 > 0 ? $1/$2 : 0) }')
+  n=$((n+1))
+done
+rm -f $macro
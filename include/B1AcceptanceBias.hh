@@ -0,0 +1,93 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AcceptanceBias.hh
+/// \brief Definition of the B1AcceptanceBias class
+
+#ifndef B1AcceptanceBias_h
+#define B1AcceptanceBias_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+/// Geometric helpers of the acceptance biasing of the primaries
+/// (/rpc/bias/), for the detector cube centred at the origin.
+///
+/// HitsCube() is the slab test of a ray against the cube, used to veto
+/// the primaries missing it before they are transported, CubeChord() also
+/// gives where the ray enters and leaves the cube.
+///
+/// SampleDirection() draws a direction towards the cube and returns the
+/// inverse of its density per solid angle, so that a primary of natural
+/// direction density f keeps an unbiased estimate with f times the returned
+/// value as weight. From outside the sphere around the cube it is uniform
+/// in the cone of the sphere (SampleCone), a ray hitting the cube always
+/// being in the cone. From inside the sphere the cone is the whole sky, so
+/// a point is drawn uniformly on the faces of the cube seen from the
+/// position instead (SampleFaces): every ray enters the cube through one
+/// point of these faces, of density per solid angle r^2/(A cos) for the
+/// seen area A. Inside the cube there is nothing to aim at and 0 is
+/// returned.
+
+class B1AcceptanceBias
+{
+  public:
+    // Ray from the position along the direction crosses the cube
+    static G4bool HitsCube(const G4ThreeVector& position,
+			   const G4ThreeVector& direction, G4double halfSize)
+    {
+      G4double tIn, tOut;
+      return CubeChord(position, direction, halfSize, tIn, tOut);
+    }
+
+    // Same, with the distances along the ray to the entry into the cube
+    // (0 from inside) and to the exit
+    static G4bool CubeChord(const G4ThreeVector& position,
+			    const G4ThreeVector& direction, G4double halfSize,
+			    G4double& tIn, G4double& tOut);
+
+    // Direction towards the cube, from the cone of its sphere or from its
+    // faces, returns the inverse of the density per solid angle, or 0 if
+    // the position is inside the cube
+    static G4double SampleDirection(const G4ThreeVector& position, G4double halfSize,
+				    G4ThreeVector& direction);
+
+    // Uniform direction in the cone of the sphere around the cube seen
+    // from the position, returns the solid angle of the cone, or 0 if
+    // the position is inside the sphere
+    static G4double SampleCone(const G4ThreeVector& position, G4double halfSize,
+			       G4ThreeVector& direction);
+
+    // Direction to a uniform point of the faces of the cube seen from the
+    // position, returns the inverse of its density per solid angle, or 0
+    // if the position is inside the cube
+    static G4double SampleFaces(const G4ThreeVector& position, G4double halfSize,
+				G4ThreeVector& direction);
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
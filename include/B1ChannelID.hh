@@ -0,0 +1,92 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ChannelID.hh
+/// \brief Definition of the B1ChannelID class
+
+#ifndef B1ChannelID_h
+#define B1ChannelID_h 1
+
+#include <cstdint>
+
+/// Packed 32-bit readout channel identifier.
+///
+/// A channel is the gas or plate pad of one RPC layer of a station, where
+/// the stations are the six cube faces (0-5) followed by the groups of the
+/// centre volume (6 onwards). The pad is given by its strip along x and
+/// its pad along y, the copy numbers of the kXAxis and kYAxis replicas.
+///
+///   bits  0- 7  y pad
+///   bits  8-15  x strip
+///   bits 16-17  cell: 0 gas, 1 + copy number of the plate otherwise
+///   bits 18-21  RPC layer in the station
+///   bits 22-25  station
+///
+/// The upper bits are unused so that the ID is a positive int in the ntuple.
+/// This header only depends on the standard library, so that the analysis
+/// macros can include it to decode the ChannelID columns.
+
+class B1ChannelID
+{
+  public:
+    enum Cell { kGas = 0, kPlate0 = 1, kPlate1 = 2 };
+
+    static const unsigned int kNofFaces = 6;
+    // Largest numbers of strips and pads of a layer, 8 bits each
+    static const unsigned int kMaxStrips = 256;
+    static const unsigned int kMaxPads = 256;
+
+    static inline uint32_t Encode(unsigned int station, unsigned int layer,
+				  unsigned int cell, unsigned int strip,
+				  unsigned int pad)
+    {
+      return  (pad & 0xFF)
+	    | (strip & 0xFF) << 8
+	    | (cell & 0x3) << 16
+	    | (layer & 0xF) << 18
+	    | (station & 0xF) << 22;
+    }
+
+    static inline unsigned int Pad(uint32_t id)     { return id & 0xFF; }
+    static inline unsigned int Strip(uint32_t id)   { return (id >> 8) & 0xFF; }
+    static inline unsigned int Cell(uint32_t id)    { return (id >> 16) & 0x3; }
+    static inline unsigned int Layer(uint32_t id)   { return (id >> 18) & 0xF; }
+    static inline unsigned int Station(uint32_t id) { return (id >> 22) & 0xF; }
+
+    static inline bool IsGas(uint32_t id)   { return Cell(id) == kGas; }
+    static inline bool IsGroup(uint32_t id) { return Station(id) >= kNofFaces; }
+
+    // Face or centre group number, depending on IsGroup()
+    static inline unsigned int Face(uint32_t id)  { return Station(id); }
+    static inline unsigned int Group(uint32_t id) { return Station(id) - kNofFaces; }
+
+    // Same RPC layer, any cell, strip and pad
+    static inline uint32_t LayerOf(uint32_t id) { return id & ~0x3FFFFu; }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
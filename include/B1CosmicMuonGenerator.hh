@@ -0,0 +1,136 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1CosmicMuonGenerator.hh
+/// \brief Definition of the B1CosmicMuonGenerator class
+
+#ifndef B1CosmicMuonGenerator_h
+#define B1CosmicMuonGenerator_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4ParticleGun;
+class G4ParticleDefinition;
+
+/// Sea-level cosmic muons around the detector cube, the vertical being +y
+/// (the top face).
+///
+/// The intensity is the Reyna parametrisation of the Bugaev/Gaisser
+/// spectrum, I(p, theta) = cos^3(theta) I_V(p cos(theta)), which falls
+/// roughly as cos^2(theta) when integrated over momentum, with a constant
+/// mu+/mu- charge ratio. The muons are started either on a horizontal plane
+/// above the cube, where the flux is weighted by cos(theta), or on a sphere
+/// around the cube, uniform over the disk perpendicular to their direction.
+/// Both are cut at the edges of the world, which limits the zenith range
+/// of the muons reaching the bottom of a large cube through the plane.
+///
+/// The (cos(theta), log p) plane is cut into cells whose fluxes fill an
+/// alias table, built once for a configuration; a primary then costs one
+/// table lookup, cos(theta) uniform and p from the local power law in the
+/// cell, whatever the size of the table. Generate() returns the live time
+/// that each primary represents, the inverse of the rate through the
+/// surface.
+///
+/// With the cone biasing (B1AcceptanceBias), the muons of the plane are
+/// aimed at the cube, at the sphere around it or, from the part of the
+/// plane inside that sphere, at the faces of the cube; the momentum then
+/// comes from the alias table of the zenith bin, and the weight is the
+/// natural density of the direction over its biased density.
+
+class B1CosmicMuonGenerator
+{
+  public:
+    B1CosmicMuonGenerator();
+    ~B1CosmicMuonGenerator();
+
+    // Settings, the tables are rebuilt at the next primary
+    void SetSphere(G4bool sphere) { fSphere = sphere; fTablesValid = false; }
+    void SetMomentumRange(G4double pMin, G4double pMax)
+    { fMinMomentum = pMin; fMaxMomentum = pMax; fTablesValid = false; }
+    void SetMaxZenith(G4double angle) { fMaxZenith = angle; fTablesValid = false; }
+    void SetChargeRatio(G4double ratio) { fChargeRatio = ratio; }
+    void SetPlaneHalfWidth(G4double width) { fPlaneHalfWidth = width; fTablesValid = false; }
+
+    // Sets the particle, momentum, direction and position of the gun for
+    // a cube and a world of these half sizes, returns the live time of the
+    // primary and its weight
+    G4double Generate(G4double halfSize, G4double worldHalfSize, G4ParticleGun* gun,
+		      G4double& weight, G4bool coneBias = false);
+
+    // Muons per unit time through the surface
+    G4double GetRate() const { return fRate; }
+
+    // Vertical intensity per unit area, time, solid angle and momentum
+    static G4double VerticalIntensity(G4double momentum);
+
+  private:
+    struct Cell
+    {
+      G4double cosMin;
+      G4double cosWidth;
+      G4double pMin;
+      G4double pMax;
+      G4double index;       // local power law p^-index
+    };
+
+    void BuildTables(G4double halfSize, G4double worldHalfSize);
+    static void BuildAlias(const G4double* weights, G4int n,
+			   G4double* probability, G4int* alias);
+    G4double SampleMomentum(const Cell& cell, G4double u) const;
+
+    G4bool fSphere;
+    G4double fMinMomentum;
+    G4double fMaxMomentum;
+    G4double fMaxZenith;
+    G4double fChargeRatio;
+    G4double fPlaneHalfWidth;   // 0 for a width set by the zenith range
+
+    G4bool fTablesValid;
+    G4double fHalfSize;         // cube and world of the tables
+    G4double fWorldHalfSize;
+    G4double fSurfaceSize;      // plane half width or sphere radius
+    G4double fRate;
+    std::vector<Cell> fCells;
+    std::vector<G4double> fProbability;
+    std::vector<G4int> fAlias;
+
+    // Density of cos(theta) and alias tables of p in each zenith bin
+    G4double fCosMin;
+    G4double fCosWidth;
+    std::vector<G4double> fCosDensity;
+    std::vector<G4double> fMomentumProbability;
+    std::vector<G4int> fMomentumAlias;
+
+    G4ParticleDefinition* fMuPlus;
+    G4ParticleDefinition* fMuMinus;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
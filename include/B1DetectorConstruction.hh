@@ -31,13 +31,57 @@
 #define B1DetectorConstruction_h 1
 
 #include "G4VUserDetectorConstruction.hh"
+#include "G4Cache.hh"
 #include "globals.hh"
 
+#include "B1GasFastSimModel.hh"
+#include "B1ElectricFieldSetup.hh"
+#include "B1RPCLayout.hh"
+
 class G4VPhysicalVolume;
 class G4LogicalVolume;
-class B1ElectricFieldSetup;
+class G4Material;
+class G4Region;
+class B1StepLimits;
+class B1DetectorMessenger;
 
 /// Detector construction class to define materials and geometry.
+///
+/// The model (full CODEX-b cube, demonstrator or silicon layers) and the
+/// RPC layout are set with the /rpc/geometry/ commands. Selecting a model
+/// resets the layout to its defaults. Changes made after initialisation
+/// rebuild the geometry before the next run (/run/reinitializeGeometry),
+/// without restarting the process or rebuilding the physics tables.
+///
+/// In the flat layout (/rpc/geometry/flat) the gas and plate pads are
+/// placed directly in the face and group envelopes, with the channel ID as
+/// copy number, instead of the RPC, gas/plate envelope and strip replica
+/// levels of the nested layout. Materials and readout cells are identical.
+///
+/// The placements are checked for overlaps once the geometry is built,
+/// unless the same geometry was checked before (B1OverlapCache).
+///
+/// The built geometry, materials included, can be written to GDML and read
+/// back instead of being built (/rpc/geometry/gdml/); the field, step
+/// limits and readout are attached to the pads read from the file. The
+/// time taken to build or read the geometry is printed.
+///
+/// The gas and plate pads are the roots of the RPCGas and RPCPlate regions,
+/// the volumes placed in the world those of the Envelope region. Each
+/// region, and the world, has production cuts and per particle step limits
+/// that can be set from macros (/rpc/region/); by default only charged
+/// particles in the gas are limited to 0.01 mm steps. In the RPCGas region
+/// the gas gap can be simulated by B1GasFastSimModel instead of the step
+/// limited transport (/rpc/fast/). Regions are kept when the geometry is
+/// rebuilt.
+///
+/// Each thread builds its own gas field, equation, stepper and driver in
+/// ConstructSDandField(), kept when the geometry is rebuilt and deleted at
+/// the end of the thread. The stepper, minimum step and accuracy of the
+/// field propagation can be changed between runs (/rpc/field/), stepper
+/// type 10 being the exact uniform field solution. The commands set the
+/// parameters on the master, and the run action of each thread applies
+/// them to its field at the start of the next run.
 
 class B1DetectorConstruction : public G4VUserDetectorConstruction
 {
@@ -46,8 +90,74 @@ public:
   virtual ~B1DetectorConstruction();
   
   virtual G4VPhysicalVolume *Construct();
+  virtual void ConstructSDandField();
+
+  // Readout options
+  void SetAggregateHits(G4bool aggregate) { fAggregateHits = aggregate; }
+  G4bool GetAggregateHits() const { return fAggregateHits; }
+
+  // Production cuts and step limits of the RPCGas, RPCPlate, Envelope and
+  // World regions, per particle or for "all"
+  void SetRegionCut(const G4String& region, const G4String& particle, G4double cut);
+  void SetRegionStepLimit(const G4String& region, const G4String& particle, G4double limit);
+
+  // Fast simulation of the gas gap
+  B1GasClusterParameters& GetClusterParameters() { return fClusterParameters; }
+
+  // Stepper and accuracy of the gas field (B1ElectricFieldSetup), set on
+  // the master and applied by each thread to its own field at the start of
+  // a run
+  const B1FieldParameters& GetFieldParameters() const { return fFieldParameters; }
+  void SetFieldParameters(const B1FieldParameters& parameters);
+  void ApplyFieldParameters() const;
+
+  // Geometry options
+  void SetModel(const G4String& model);
+  void SetDetectorSize(G4double size);
+  void SetGasThickness(G4double thickness);
+  void SetPlateThickness(G4double thickness);
+  void SetPadSizeX(G4double size);
+  void SetPadSizeY(G4double size);
+  void SetLayerSeparation(G4double separation);
+  void SetFaceLayers(G4int n);
+  void SetLayersPerGroup(G4int n);
+  void SetCentreGroups(G4int n);
+  void SetFlatLayout(G4bool flat);
+  void SetSmartless(G4double smartless);
+
+  // Layer parameters in the form shared with the acceptance engine
+  B1RPCLayout GetLayout() const;
+  void WriteLayout(const G4String& fileName) const;
+
+  // Overlap check of the built geometry, skipped if found in the cache file
+  void SetCheckOverlaps(G4bool check) { fCheckOverlaps = check; }
+  void SetOverlapCacheFile(const G4String& fileName) { fOverlapCacheFile = fileName; }
+
+  // GDML geometry, an empty file name builds the geometry in Construct()
+  void SetGdmlReadFile(const G4String& fileName);
+  void WriteGdml(const G4String& fileName) const;
+
+  // Time the navigation in the geometry of the last run
+  void BenchmarkNavigation(G4int nRays) const;
+
+  // Time runs and the propagation of gas electrons for a set of field
+  // integration settings
+  void BenchmarkField(G4int nEvents, G4int nElectrons);
   
 protected:
+  G4VPhysicalVolume* ConstructVolumes();
+  G4VPhysicalVolume* ReadGdml();
+  void ConfigureReadout(G4LogicalVolume* logicGas, G4LogicalVolume* logicPlate);
+  void ConfigureRegions(G4VPhysicalVolume* physWorld);
+  void ReleaseRegions();
+  G4Region* FindRegion(const G4String& regionName) const;
+  G4Material* GasMaterial();
+  void CheckOverlaps() const;
+  void PlacePads(G4LogicalVolume* logicMother, G4double motherThick, G4int nLayers,
+		 G4LogicalVolume* logicGas, G4LogicalVolume* logicPlate,
+		 G4int nStrips, G4int nPads);
+  void GeometryChanged();
+
   bool fSiliconModel = false;
   bool fCodexb = true;
   G4double detSizeXY;
@@ -55,6 +165,40 @@ protected:
   G4int nFaceLayers;
   G4int nPerCentreGroup;
   G4int nCentreLayers;
+  G4double gasThick;
+  G4double plateThick;
+  G4double plateSizeX;
+  G4double plateSizeY;
+  G4bool fFlatLayout = false;
+  G4double fSmartless = 2.;
+
+  G4bool fCheckOverlaps = true;
+  G4String fOverlapCacheFile = "overlaps.cache";
+
+  G4String fGdmlReadFile;
+
+  // Readout volumes, sensitive detectors are attached to these
+  G4LogicalVolume *fLogicGas = nullptr;
+  G4LogicalVolume *fLogicPlate = nullptr;
+
+  G4bool fAggregateHits = false;
+
+  B1GasClusterParameters fClusterParameters;
+
+  // Field of the gas, one per thread, and its integration parameters
+  G4Cache<B1ElectricFieldSetup*> fFieldSetup;
+  B1FieldParameters fFieldParameters;
+
+  // Regions and their step limits
+  G4Region *fGasRegion;
+  G4Region *fPlateRegion;
+  G4Region *fEnvelopeRegion;
+  B1StepLimits *fGasLimits;
+  B1StepLimits *fPlateLimits;
+  B1StepLimits *fEnvelopeLimits;
+  B1StepLimits *fWorldLimits;
+
+  B1DetectorMessenger *fMessenger;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
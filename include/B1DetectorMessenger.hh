@@ -0,0 +1,156 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1DetectorMessenger.hh
+/// \brief Definition of the B1DetectorMessenger class
+
+#ifndef B1DetectorMessenger_h
+#define B1DetectorMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class B1DetectorConstruction;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWith3Vector;
+
+/// Messenger class that defines commands for B1DetectorConstruction.
+///
+/// It implements commands:
+/// - /rpc/readout/aggregate true|false
+/// - /rpc/geometry/model codexb|demonstrator|silicon
+/// - /rpc/geometry/size value unit
+/// - /rpc/geometry/gasThickness value unit
+/// - /rpc/geometry/plateThickness value unit
+/// - /rpc/geometry/padSizeX value unit
+/// - /rpc/geometry/padSizeY value unit
+/// - /rpc/geometry/layerSeparation value unit
+/// - /rpc/geometry/faceLayers n
+/// - /rpc/geometry/layersPerGroup n
+/// - /rpc/geometry/centreGroups n
+/// - /rpc/geometry/flat true|false
+/// - /rpc/geometry/smartless value
+/// - /rpc/geometry/benchmark nRays
+/// - /rpc/geometry/checkOverlaps true|false
+/// - /rpc/geometry/overlapCache fileName
+/// - /rpc/geometry/writeLayout fileName
+/// - /rpc/geometry/gdml/read fileName
+/// - /rpc/geometry/gdml/write fileName
+/// - /rpc/region/cut region particle value unit
+/// - /rpc/region/stepLimit region particle value unit
+/// - /rpc/fast/gas true|false
+/// - /rpc/fast/clusterDensity value (per mm)
+/// - /rpc/fast/singleFraction value
+/// - /rpc/fast/ionisationEnergy value unit
+/// - /rpc/fast/minBetaGamma value
+/// - /rpc/field/stepper type
+/// - /rpc/field/minStep value unit
+/// - /rpc/field/deltaChord value unit
+/// - /rpc/field/deltaOneStep value unit
+/// - /rpc/field/deltaIntersection value unit
+/// - /rpc/field/epsilonMin value
+/// - /rpc/field/epsilonMax value
+/// - /rpc/field/trackMode particle momentum unit integrate|coarse|straight
+/// - /rpc/field/map fileName
+/// - /rpc/field/value Ex Ey Ez (kV/cm)
+/// - /rpc/field/benchmark nEvents nElectrons
+
+class B1DetectorMessenger: public G4UImessenger
+{
+  public:
+    B1DetectorMessenger(B1DetectorConstruction* );
+    virtual ~B1DetectorMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    G4UIcmdWithADoubleAndUnit* NewLengthCommand(const char* name, const char* guidance);
+    G4UIcmdWithAnInteger* NewCountCommand(const char* name, const char* guidance,
+					   const char* range);
+    G4UIcommand* NewRegionCommand(const char* name, const char* particles);
+
+    B1DetectorConstruction*  fDetectorConstruction;
+
+    G4UIdirectory*           fRpcDirectory;
+    G4UIdirectory*           fReadoutDirectory;
+    G4UIdirectory*           fGeometryDirectory;
+    G4UIdirectory*           fGdmlDirectory;
+    G4UIdirectory*           fRegionDirectory;
+    G4UIdirectory*           fFastDirectory;
+    G4UIdirectory*           fFieldDirectory;
+
+    G4UIcmdWithABool*        fAggregateCmd;
+
+    G4UIcmdWithAString*        fModelCmd;
+    G4UIcmdWithADoubleAndUnit* fSizeCmd;
+    G4UIcmdWithADoubleAndUnit* fGasThicknessCmd;
+    G4UIcmdWithADoubleAndUnit* fPlateThicknessCmd;
+    G4UIcmdWithADoubleAndUnit* fPadSizeXCmd;
+    G4UIcmdWithADoubleAndUnit* fPadSizeYCmd;
+    G4UIcmdWithADoubleAndUnit* fLayerSeparationCmd;
+    G4UIcmdWithAnInteger*      fFaceLayersCmd;
+    G4UIcmdWithAnInteger*      fLayersPerGroupCmd;
+    G4UIcmdWithAnInteger*      fCentreGroupsCmd;
+    G4UIcmdWithABool*          fFlatCmd;
+    G4UIcmdWithADouble*        fSmartlessCmd;
+    G4UIcmdWithAnInteger*      fBenchmarkCmd;
+    G4UIcmdWithABool*          fCheckOverlapsCmd;
+    G4UIcmdWithAString*        fOverlapCacheCmd;
+    G4UIcmdWithAString*        fWriteLayoutCmd;
+    G4UIcmdWithAString*        fGdmlReadCmd;
+    G4UIcmdWithAString*        fGdmlWriteCmd;
+
+    G4UIcommand*               fRegionCutCmd;
+    G4UIcommand*               fRegionStepLimitCmd;
+
+    G4UIcmdWithABool*          fFastGasCmd;
+    G4UIcmdWithADouble*        fClusterDensityCmd;
+    G4UIcmdWithADouble*        fSingleFractionCmd;
+    G4UIcmdWithADoubleAndUnit* fIonisationEnergyCmd;
+    G4UIcmdWithADouble*        fMinBetaGammaCmd;
+
+    G4UIcmdWithAnInteger*      fStepperCmd;
+    G4UIcmdWithADoubleAndUnit* fMinStepCmd;
+    G4UIcmdWithADoubleAndUnit* fDeltaChordCmd;
+    G4UIcmdWithADoubleAndUnit* fDeltaOneStepCmd;
+    G4UIcmdWithADoubleAndUnit* fDeltaIntersectionCmd;
+    G4UIcmdWithADouble*        fEpsilonMinCmd;
+    G4UIcmdWithADouble*        fEpsilonMaxCmd;
+    G4UIcommand*               fTrackModeCmd;
+    G4UIcmdWithAString*        fFieldMapCmd;
+    G4UIcmdWith3Vector*        fFieldValueCmd;
+    G4UIcommand*               fFieldBenchmarkCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -37,21 +37,68 @@
 
 #include "G4ElectricField.hh"
 #include "G4UniformElectricField.hh"
+#include "G4ThreeVector.hh"
+#include "G4SystemOfUnits.hh"
+
+#include "B1FieldTrackMode.hh"
+
+#include <vector>
 
 class G4FieldManager;
+class B1GasFieldManager;
 class G4ChordFinder;
 class G4EquationOfMotion;
 class G4Mag_EqRhs;
-class G4EqMagElectricField;
+class B1EqElectricField;
 class G4MagIntegratorStepper;
 class G4MagInt_Driver;
 
+/// Rule of the propagation of fast tracks (B1GasFieldManager)
+
+struct B1FieldTrackRule
+{
+  G4String particle;       // particle name, or "all"
+  G4double minMomentum;
+  B1FieldTrackMode mode;
+};
+
+/// Integration parameters of the field, set with the /rpc/field/ commands
+
+struct B1FieldParameters
+{
+  G4ThreeVector fieldValue                 // uniform field of the gas, and
+    = G4ThreeVector(0., 0., -54*kilovolt/cm); //   outside a field map
+  G4int stepperType = 4;                   // ClassicalRK4
+  G4double minStep = 0.010*mm;             // minimum step of the driver
+  G4double deltaChord = 0.25*mm;           // miss distance of the chords
+  G4double deltaOneStep = 0.01*mm;         // accuracy of the endpoint of a step
+  G4double deltaIntersection = 0.001*mm;   // accuracy of the boundary crossing
+  G4double epsilonMin = 5.0e-5;            // relative accuracy of a step,
+  G4double epsilonMax = 1.0e-3;            //   between these bounds
+  std::vector<B1FieldTrackRule> trackRules; // fast tracks, none by default
+  G4String fieldMap;                       // gridded field map, empty for
+                                           //   the uniform field
+};
+
 /// A class for control of the Electric Field of the detector.
 ///     The field for this case is uniform.
 ///
 /// The field for this case is uniform.
 /// It is simply a 'setup' class that creates the field and necessary
 /// other parts
+///
+/// Stepper type 10 is B1UniformElectricStepper, the exact trajectory in
+/// the uniform field, in place of the Runge-Kutta steppers 0-5; types
+/// 11-13 are the embedded Dormand-Prince, Bogacki-Shampine and Tsitouras
+/// steppers.
+///
+/// With a field map (B1FieldParameters::fieldMap) the uniform field is
+/// replaced by a B1GriddedElectricField, which keeps the uniform value
+/// outside the grid.
+///
+/// The field value and map can change between runs (/rpc/field/value,
+/// /rpc/field/map): each thread swaps its own field, while the equation
+/// and the field manager stay in place.
 
 class B1ElectricFieldSetup
 {
@@ -66,17 +113,22 @@ public:
 
   void SetMinStep(G4double s) { fMinStep = s ; }
 
+  void SetParameters(const B1FieldParameters& parameters);
+   // Stepper, minimum step and accuracy of the field manager and chord finder
+
   void SetFieldValue(G4ThreeVector fieldVector);
   void SetFieldZValue(G4double      fieldValue);
-  G4ThreeVector GetConstantFieldValue();
-   // Set/Get Field strength in Geant4 units
+  G4ThreeVector GetConstantFieldValue() const { return fElFieldValue; }
+   // Set/Get Field strength in Geant4 units. The new field replaces the
+   //   old one in the equation and the field manager before the old one
+   //   is deleted; a zero uniform field is not propagated.
 
   void UpdateIntegrator();
    // Prepare all the classes required for tracking - from stepper 
    //    to Chord-Finder
    //   NOTE:  field and equation must have been created before calling this.
 
-  G4FieldManager* GetLocalFieldManager(){return fFieldManager;};
+  G4FieldManager* GetLocalFieldManager();
    
 protected:
 
@@ -87,19 +139,23 @@ protected:
   void CreateStepper();
    // Implementation method - should not be exposed
 
+  void CreateField(const G4String& fieldMap);
+   // Uniform field, or the gridded map if a file is given
+
 private:
   G4double                fMinStep;
   G4bool                  fVerbose;
 
-  G4FieldManager*         fFieldManager;
+  B1GasFieldManager*      fFieldManager;
 
   G4ChordFinder*          fChordFinder;
 
-  G4EqMagElectricField*   fEquation;
+  B1EqElectricField*      fEquation;
 
   G4ElectricField*        fEMfield;
  
   G4ThreeVector           fElFieldValue;
+  G4String                fFieldMap;
 
   G4MagIntegratorStepper* fStepper;
   G4MagInt_Driver*        fIntgrDriver;
@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+//
+/// \file B1EqElectricField.hh
+/// \brief Definition of the B1EqElectricField class
+
+#ifndef B1EqElectricField_h
+#define B1EqElectricField_h 1
+
+#include "G4EqMagElectricField.hh"
+#include "globals.hh"
+
+/// Equation of motion in an electric field which keeps the charge and mass
+/// of the track, for the steppers using the analytic solution
+/// (B1UniformElectricStepper).
+
+class B1EqElectricField : public G4EqMagElectricField
+{
+  public:
+    B1EqElectricField(G4ElectroMagneticField* field);
+    virtual ~B1EqElectricField();
+
+    virtual void SetChargeMomentumMass(G4ChargeState particleCharge,
+				       G4double momentum, G4double mass);
+
+    // Charge in units of eplus and mass of the current track
+    G4double GetCharge() const { return fCharge; }
+    G4double GetMass() const { return fMass; }
+
+  private:
+    G4double fCharge;
+    G4double fMass;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -33,12 +33,17 @@
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 
-#include <vector>
+#include "B1HitBuffer.hh"
+#include "B1RPCHit.hh"
 
 class B1RunAction;
 
 /// Event action class
 ///
+/// At the end of the event, the gas and plate hits collections of the RPC
+/// sensitive detectors are appended to the gas and plate streams of the hit
+/// buffer of the run action, whose arrays are the ntuple columns, and the
+/// ntuple row is added.
 
 class B1EventAction : public G4UserEventAction
 {
@@ -49,40 +54,18 @@ class B1EventAction : public G4UserEventAction
     virtual void BeginOfEventAction(const G4Event *event);
     virtual void EndOfEventAction(const G4Event *event);
 
-    virtual void HitPos(G4double x, G4double y, G4double z);
-    virtual void EnergyDep(G4double value){edep->push_back(value);};
-    virtual void Time(G4double value){time->push_back(value);};
-    virtual void DeltaEnergy(G4double value){deltaEnergy->push_back(value);};
-    virtual void IDNumbers(G4int pID, G4int tID, G4int prntID);
-
-    virtual void FinalEnergy(G4double value){finalEnergy->at(0)=value;};
-
-    virtual void AvalancheCount(){avalancheSize->at(0)+=1;};
-    virtual void AvalancheEnergy(G4double value){avalancheEnergy->push_back(value);};
-
-    virtual void LayerCounter(){layerCount->at(0)+=1;};
-  
+    void FinalEnergy(G4double value);
 
   private:
-    B1RunAction *fRunAction;
-
-    std::vector<double> *hitPosX;
-    std::vector<double> *hitPosY;
-    std::vector<double> *hitPosZ;
-    std::vector<double> *edep;
-    std::vector<double> *time;
-    std::vector<double> *deltaEnergy;
-    std::vector<int> *particleID;
-    std::vector<int> *trackID;
-    std::vector<int> *parentID;
+    void AppendHits(const B1RPCHitsCollection* hits, B1HitBuffer::Stream& stream);
 
-    G4double initEnergy = 0;
-    std::vector<double> *finalEnergy;
+    B1RunAction *fRunAction;
 
-    std::vector<int> *avalancheSize;
-    std::vector<double> *avalancheEnergy;
+    G4int fGasHitsID;
+    G4int fPlateHitsID;
+    G4int fCrossingsID;
 
-    std::vector<int> *layerCount;
+    B1HitBuffer *fHits;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,123 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventFile.hh
+/// \brief Definition of the B1EventFile class
+
+#ifndef B1EventFile_h
+#define B1EventFile_h 1
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Events generated outside Geant4, memory-mapped from a file.
+///
+/// Two formats are read:
+/// - the B1EventFile binary format, a Header, the events (an EventHeader
+///   followed by its Particle records) and an index of the event offsets,
+///   written by Write() or by the tools/eventfile converter;
+/// - HepMC3 ASCII, whose events are found with one scan of the file at
+///   Open() and parsed when they are read. The final-state particles
+///   (status 1) are kept, at the position of their production vertex.
+///
+/// Momenta are in MeV, positions in mm and times in ns, the Geant4
+/// internal units. The file is mapped read-only and shared by the threads:
+/// Read() is const, and Claim() hands out ranges of events from an atomic
+/// cursor, so the threads never wait for each other. Like B1RPCLayout,
+/// this class only depends on the standard library (and POSIX mmap).
+
+class B1EventFile
+{
+  public:
+    struct Header
+    {
+      char magic[8];          // "B1EVTS01"
+      uint64_t nEvents;
+      uint64_t indexOffset;   // nEvents + 1 offsets from the file start
+    };
+
+    struct EventHeader
+    {
+      uint32_t number;        // event number of the generator
+      uint32_t nParticles;
+    };
+
+    struct Particle
+    {
+      int32_t pdg;
+      int32_t reserved;
+      double momentum[3];
+      double position[4];     // x, y, z, t
+    };
+
+    B1EventFile();
+    ~B1EventFile();
+
+    // Maps the file and indexes its events, false with a message if it
+    // cannot be used
+    bool Open(const std::string& fileName, std::string& error);
+    void Close();
+    bool IsOpen() const { return fData != nullptr; }
+    bool IsHepMC() const { return fHepMC; }
+
+    size_t NofEvents() const { return fOffsets.empty() ? 0 : fOffsets.size() - 1; }
+
+    // Particles of an event, false if it cannot be parsed
+    bool Read(size_t event, std::vector<Particle>& particles, uint32_t& number) const;
+
+    // Takes up to nEvents from the cursor, returns the first one in begin
+    // and the number taken, 0 once all events have been taken
+    size_t Claim(size_t nEvents, size_t& begin);
+    void Rewind(size_t event = 0) { fCursor = event; }
+
+    // Writes events in the binary format, the particles of event i being
+    // particles[offsets[i]] to particles[offsets[i+1]]
+    static bool Write(const std::string& fileName, const std::vector<uint32_t>& numbers,
+		      const std::vector<size_t>& offsets,
+		      const std::vector<Particle>& particles);
+
+  private:
+    B1EventFile(const B1EventFile&) = delete;
+    B1EventFile& operator=(const B1EventFile&) = delete;
+
+    bool IndexBinary(std::string& error);
+    bool IndexHepMC(std::string& error);
+    bool ReadHepMC(size_t event, std::vector<Particle>& particles, uint32_t& number) const;
+
+    void* fMapping;
+    size_t fSize;
+    const char* fData;
+    bool fHepMC;
+    std::vector<uint64_t> fOffsets;
+    std::atomic<size_t> fCursor;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
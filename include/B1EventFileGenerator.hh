@@ -0,0 +1,80 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventFileGenerator.hh
+/// \brief Definition of the B1EventFileGenerator class
+
+#ifndef B1EventFileGenerator_h
+#define B1EventFileGenerator_h 1
+
+#include "G4VPrimaryGenerator.hh"
+#include "globals.hh"
+
+#include "B1EventFile.hh"
+
+#include <vector>
+
+class G4Event;
+
+/// Primaries read from an external event file (B1EventFile, binary or
+/// HepMC3 ASCII), selected with /rpc/input/file.
+///
+/// A file is opened once per process and shared by the worker threads.
+/// Each generator claims chunks of consecutive events from the shared
+/// cursor and reads them without locking; the file is read once across
+/// the runs, the events of the next run following those of the previous
+/// one. The particles of an event are grouped in primary vertices by
+/// position. Particles unknown to Geant4 are skipped, and the run is
+/// aborted once the file is exhausted.
+
+class B1EventFileGenerator : public G4VPrimaryGenerator
+{
+  public:
+    B1EventFileGenerator();
+    virtual ~B1EventFileGenerator();
+
+    virtual void GeneratePrimaryVertex(G4Event* event);
+
+    // Shared file, opened at the first call, nullptr with a warning if it
+    // cannot be read
+    void SetFile(const G4String& fileName);
+    G4bool IsOpen() const { return fFile != nullptr; }
+
+    // Events claimed at a time from the shared cursor
+    void SetChunk(G4int chunk) { fChunk = chunk; }
+
+  private:
+    B1EventFile* fFile;
+    G4int fChunk;
+    size_t fNext;          // range of events claimed by this thread
+    size_t fEnd;
+    std::vector<B1EventFile::Particle> fParticles;
+    G4int fNofSkipped;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1FieldBenchmark.hh
+/// \brief Definition of the B1FieldBenchmark class
+
+#ifndef B1FieldBenchmark_h
+#define B1FieldBenchmark_h 1
+
+#include "B1ElectricFieldSetup.hh"
+#include "B1RPCLayout.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4VPhysicalVolume;
+class G4LogicalVolume;
+class B1DetectorConstruction;
+
+/// Field integration benchmark
+///
+/// For a set of steppers and accuracy settings, it times a run of the same
+/// seeded events, and the propagation in the field alone of a fixed sample
+/// of avalanche-like electrons (10 eV to 5 keV, log uniform, isotropic,
+/// from random points of the gas layers) until they leave the gas. The
+/// settings of a row are set on the detector construction, which the
+/// threads apply to their fields at the start of the run, and on a field of
+/// the benchmark used for the electrons, so that it also runs on the master
+/// of a multi-threaded job. The field value and map, and the rules of the
+/// fast tracks, are those of the given settings. The gas exit points are
+/// compared with those of the exact stepper at tight accuracy. It prints a
+/// table of events/s, electrons/s and the mean and maximum endpoint error,
+/// then restores the given settings.
+
+class B1FieldBenchmark
+{
+  public:
+    B1FieldBenchmark(B1DetectorConstruction* detector, G4VPhysicalVolume* world,
+		     G4LogicalVolume* logicGas);
+    ~B1FieldBenchmark();
+
+    void Run(G4int nEvents, G4int nElectrons);
+
+  private:
+    void SampleElectrons(G4int nElectrons);
+    void Apply(const B1FieldParameters& parameters);
+    G4double RunEvents(G4int nEvents) const;
+    G4double PropagateElectrons(std::vector<G4ThreeVector>& endPoints,
+				std::vector<G4bool>& inGas);
+
+    B1DetectorConstruction* fDetector;
+    G4VPhysicalVolume* fWorld;
+    G4LogicalVolume* fLogicGas;
+    B1RPCLayout fLayout;
+    B1FieldParameters fParameters; // Restored at the end, base of all rows
+    B1ElectricFieldSetup fSetup;   // Field of the electrons
+
+    // Electron sample
+    std::vector<G4ThreeVector> fStarts;
+    std::vector<G4ThreeVector> fDirections;
+    std::vector<G4double> fEnergies;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
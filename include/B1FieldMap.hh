@@ -0,0 +1,106 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1FieldMap.hh
+/// \brief Definition of the B1FieldMap class
+
+#ifndef B1FieldMap_h
+#define B1FieldMap_h 1
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// Gridded field map, memory-mapped from a binary file.
+///
+/// The file is a B1FieldMap::Header followed by the field at the nodes of
+/// a regular grid, four floats per node (x, y, z and padding, x fastest),
+/// so that the eight corners of a cell are loaded and blended as 4-wide
+/// vectors. Positions are in mm, the Geant4 internal unit, and the field
+/// in the unit of the producer (kV/cm for B1GriddedElectricField). The
+/// map is opened read-only and shared by the threads through the page
+/// cache.
+///
+/// Evaluate() interpolates trilinearly. The caller keeps a Cache, one per
+/// thread, holding the corners of the last cell: the successive queries of
+/// a Runge-Kutta step nearly always fall in the same cell and skip the
+/// index computation and the eight gathers. Like B1RPCLayout, this class
+/// only depends on the standard library (and POSIX mmap), for the
+/// standalone benchmark in tools/fieldmap.
+
+class B1FieldMap
+{
+  public:
+    struct Header
+    {
+      char magic[8];          // "B1EMAP01"
+      uint32_t nodes[3];      // nodes along x, y, z, at least 2
+      uint32_t flags;
+      double min[3];          // first and last nodes, mm
+      double max[3];
+      uint32_t reserved[2];   // pads the header to 80 bytes
+    };
+
+    struct Cache
+    {
+      long cell = -1;           // linear index of the first corner
+      float corners[8][4];
+    };
+
+    B1FieldMap();
+    ~B1FieldMap();
+
+    // Maps the file, false with a message if it cannot be used
+    bool Open(const std::string& fileName, std::string& error);
+    void Close();
+    bool IsOpen() const { return fValues != nullptr; }
+
+    // Field at a position, false outside the grid
+    bool Evaluate(const double position[3], double field[3], Cache& cache) const;
+
+    // Writes a map, values as in the file (4 floats per node)
+    static bool Write(const std::string& fileName, const uint32_t nodes[3],
+		      const double min[3], const double max[3], const float* values);
+
+    const Header& GetHeader() const { return *fHeader; }
+
+  private:
+    B1FieldMap(const B1FieldMap&) = delete;
+    B1FieldMap& operator=(const B1FieldMap&) = delete;
+
+    void* fMapping;
+    size_t fMappingSize;
+    const Header* fHeader;
+    const float* fValues;
+    double fMin[3];
+    double fInvStep[3];
+    long fNodes[3];
+    long fStride[3];          // in nodes
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
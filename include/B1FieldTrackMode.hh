@@ -24,33 +24,19 @@
 // ********************************************************************
 //
 //
-/// \file B1SteppingAction.hh
-/// \brief Definition of the B1SteppingAction class
+/// \file B1FieldTrackMode.hh
+/// \brief Definition of the B1FieldTrackMode enumeration
 
-#ifndef B1SteppingAction_h
-#define B1SteppingAction_h 1
+#ifndef B1FieldTrackMode_h
+#define B1FieldTrackMode_h 1
 
-#include "G4UserSteppingAction.hh"
-#include "globals.hh"
+/// Propagation of the tracks above the momentum of a rule (B1GasFieldManager)
 
-class B1EventAction;
-
-class G4LogicalVolume;
-
-/// Stepping action class
-/// 
-
-class B1SteppingAction : public G4UserSteppingAction
+enum B1FieldTrackMode
 {
-  public:
-    B1SteppingAction(B1EventAction* eventAction);
-    virtual ~B1SteppingAction();
-
-    // method from the base class
-    virtual void UserSteppingAction(const G4Step*);
-
-  private:
-    B1EventAction*  fEventAction;
+  kFieldIntegrated,    // integrated with the field accuracy
+  kFieldCoarse,        // integrated with the coarse accuracy
+  kFieldStraight       // straight line, the field is ignored
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,113 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1GasCrossingHit.hh
+/// \brief Definition of the B1GasCrossingHit class
+
+#ifndef B1GasCrossingHit_h
+#define B1GasCrossingHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "tls.hh"
+
+/// Gas crossing hit class
+///
+/// One hit is stored each time the primary particle leaves a gas cell, and
+/// each time an electron produced in the gas leaves it into a plate
+/// (an avalanche electron). The fast simulation of the gas stores its
+/// primary clusters as hits of their own, with the number of electrons of
+/// the cluster. The event action derives the layer count, the avalanche size
+/// and energies and the clusters from these hits.
+
+class B1GasCrossingHit : public G4VHit
+{
+  public:
+    B1GasCrossingHit();
+    B1GasCrossingHit(const B1GasCrossingHit&);
+    virtual ~B1GasCrossingHit();
+
+    // operators
+    const B1GasCrossingHit& operator=(const B1GasCrossingHit&);
+    G4int operator==(const B1GasCrossingHit&) const;
+
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+
+    // methods from base class
+    virtual void Print();
+
+    // Set methods
+    void SetTrackID(G4int id)    { fTrackID = id; };
+    void SetParentID(G4int id)   { fParentID = id; };
+    void SetPrimaryID(G4int id)  { fPrimaryID = id; };
+    void SetVertexEnergy(G4double e) { fVertexEnergy = e; };
+    void SetAvalanche(G4bool avalanche) { fAvalanche = avalanche; };
+    void SetClusterSize(G4int size) { fClusterSize = size; };
+
+    // Get methods
+    G4int GetTrackID() const     { return fTrackID; };
+    G4int GetParentID() const    { return fParentID; };
+    G4int GetPrimaryID() const   { return fPrimaryID; };
+    G4double GetVertexEnergy() const { return fVertexEnergy; };
+    G4bool IsAvalanche() const   { return fAvalanche; };
+    G4int GetClusterSize() const { return fClusterSize; };
+
+  private:
+    G4int    fTrackID;
+    G4int    fParentID;
+    G4int    fPrimaryID;
+    G4double fVertexEnergy;
+    G4bool   fAvalanche;
+    G4int    fClusterSize;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+typedef G4THitsCollection<B1GasCrossingHit> B1GasCrossingHitsCollection;
+
+extern G4ThreadLocal G4Allocator<B1GasCrossingHit>* B1GasCrossingHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* B1GasCrossingHit::operator new(size_t)
+{
+  if(!B1GasCrossingHitAllocator)
+      B1GasCrossingHitAllocator = new G4Allocator<B1GasCrossingHit>;
+  return (void *) B1GasCrossingHitAllocator->MallocSingle();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1GasCrossingHit::operator delete(void *hit)
+{
+  B1GasCrossingHitAllocator->FreeSingle((B1GasCrossingHit*) hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1GasFastSimModel.hh
+/// \brief Definition of the B1GasFastSimModel class
+
+#ifndef B1GasFastSimModel_h
+#define B1GasFastSimModel_h 1
+
+#include "G4VFastSimulationModel.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class B1RPCSensitiveDetector;
+
+/// Parameters of the primary ionisation in the gas, set with the
+/// /rpc/fast/ commands
+
+struct B1GasClusterParameters
+{
+  G4bool enabled = false;                  // fast simulation of the gas gap
+  G4double clusterDensity = 9.5/mm;        // mean number of clusters per length
+  G4double singleFraction = 0.75;          // fraction of one electron clusters
+  G4double ionisationEnergy = 30*eV;       // energy per electron-ion pair (W)
+  G4double minBetaGamma = 3.;              // slower particles are transported
+};
+
+/// Fast simulation model of the RPC gas gap
+///
+/// Attached to the RPCGas region, whose root volume is the gas pad. Charged
+/// particles above the beta gamma threshold are not transported through the
+/// gas: the primary clusters are sampled along their straight chord through
+/// the pad, a Poisson number with the cluster density, at uniform positions,
+/// with one electron or a 1/n^2 tail of sizes up to 100 electrons. Each
+/// cluster deposits n W and gives a gas hit, and is written to the Cluster
+/// columns with its number of electrons. The particle is moved to the exit
+/// of the pad with its energy reduced by the deposit.
+///
+/// The clusters are not avalanche electrons: with full transport these are
+/// the electrons produced in the gas above the production cut that reach a
+/// plate, while the primary ionisation below the cut is deposited locally.
+/// The model produces no such electrons, so its avalanche columns stay empty
+/// and its Cluster columns have no counterpart in the full transport.
+///
+/// With /rpc/fast/gas false (the default) the model is not triggered and the
+/// gas is simulated with the step limited transport, the validation mode.
+
+class B1GasFastSimModel : public G4VFastSimulationModel
+{
+  public:
+    B1GasFastSimModel(const G4String& name, G4Region* envelope,
+		      B1RPCSensitiveDetector* gasDetector,
+		      const B1GasClusterParameters* parameters);
+    virtual ~B1GasFastSimModel();
+
+    // methods from base class
+    virtual G4bool IsApplicable(const G4ParticleDefinition& particle);
+    virtual G4bool ModelTrigger(const G4FastTrack& fastTrack);
+    virtual void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep);
+
+  private:
+    G4int SampleClusterSize();
+
+    B1RPCSensitiveDetector* fGasDetector;
+    const B1GasClusterParameters* fParameters;
+
+    // Cumulative cluster size distribution, rebuilt when the fraction of
+    // single electron clusters is changed
+    std::vector<G4double> fClusterSizeCDF;
+    G4double fTableSingleFraction;
+
+    std::vector<G4double> fClusterPositions;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,85 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+//
+/// \file B1GasFieldManager.hh
+/// \brief Definition of the B1GasFieldManager class
+
+#ifndef B1GasFieldManager_h
+#define B1GasFieldManager_h 1
+
+#include "B1ElectricFieldSetup.hh"
+#include "G4FieldManager.hh"
+#include "globals.hh"
+
+#include <utility>
+#include <vector>
+
+class G4ParticleDefinition;
+
+/// Field manager of the gas with a propagation mode per track
+///
+/// Fast tracks hardly feel the gas field (a 10 GeV muon is deflected by
+/// well under a micron over the gap), so above the momentum of a rule for
+/// their particle, or of the rule for all particles, they are integrated
+/// with a coarse accuracy or moved in straight lines instead. Slower
+/// tracks, the avalanche electrons in particular, are integrated with the
+/// accuracy of the field parameters. The tracks taking each path are
+/// counted by the run action of the thread (B1RunAction), and printed at
+/// the end of the run.
+
+class B1GasFieldManager : public G4FieldManager
+{
+  public:
+    B1GasFieldManager();
+    virtual ~B1GasFieldManager();
+
+    virtual void ConfigureForTrack(const G4Track* track);
+
+    // Field of the integrated tracks
+    void SetGasField(G4Field* field);
+    // Accuracy of the integrated tracks and rules of the fast tracks
+    void SetParameters(const B1FieldParameters& parameters);
+
+  private:
+    void ApplyMode(B1FieldTrackMode mode);
+
+    G4Field* fGasField;
+    B1FieldParameters fParameters;
+    // Rules with their particle, null for all particles
+    std::vector<std::pair<const G4ParticleDefinition*, B1FieldTrackRule>> fRules;
+    B1FieldTrackMode fMode;
+
+    // Last track configured, to count each track once
+    const G4Track* fLastTrack;
+    G4int fLastTrackID;
+    G4int fLastStepNumber;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
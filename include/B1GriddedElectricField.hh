@@ -0,0 +1,66 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1GriddedElectricField.hh
+/// \brief Definition of the B1GriddedElectricField class
+
+#ifndef B1GriddedElectricField_h
+#define B1GriddedElectricField_h 1
+
+#include "G4ElectricField.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include "B1FieldMap.hh"
+
+/// Electric field of the gas interpolated in a gridded map (B1FieldMap),
+/// in global coordinates and kV/cm, selected with /rpc/field/map.
+///
+/// Outside the grid the field is the nominal uniform value. The map keeps
+/// the corners of the last cell in a cache; the field setups are per
+/// thread, so each thread queries its own instance.
+
+class B1GriddedElectricField : public G4ElectricField
+{
+  public:
+    B1GriddedElectricField(const G4String& fileName,
+			   const G4ThreeVector& outsideValue);
+    virtual ~B1GriddedElectricField();
+
+    virtual void GetFieldValue(const G4double point[4], G4double* field) const;
+
+    const G4String& GetFileName() const { return fFileName; }
+
+  private:
+    G4String fFileName;
+    G4ThreeVector fOutsideValue;
+    B1FieldMap fMap;
+    mutable B1FieldMap::Cache fCache;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
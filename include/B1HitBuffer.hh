@@ -0,0 +1,221 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HitBuffer.hh
+/// \brief Definition of the B1HitBuffer class
+
+#ifndef B1HitBuffer_h
+#define B1HitBuffer_h 1
+
+#include "G4ThreeVector.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Per-thread structure-of-arrays buffer of the ntuple columns.
+///
+/// Gas and plate hits are kept in separate typed streams, each with its own
+/// energy column (change in kinetic energy for the gas, energy deposit for
+/// the plates), so no placeholder values are written. Each hit carries the
+/// packed ID of its readout channel (B1ChannelID), its position is only
+/// appended if requested.
+///
+/// The ntuple vector columns are bound directly to the arrays below, so
+/// nothing is copied when a row is added. Reset() only rewinds the arrays:
+/// their storage is kept from event to event, and Reserve() grows it ahead
+/// of the fill with some headroom over the largest event seen by the thread
+/// (the high-water mark), so showering events do not reallocate while
+/// appending.
+
+class B1HitBuffer
+{
+  public:
+    /// Columns of one hit stream
+    struct Stream
+    {
+      std::vector<double> hitPosX;
+      std::vector<double> hitPosY;
+      std::vector<double> hitPosZ;
+      std::vector<double> time;
+      std::vector<double> energy;
+      std::vector<int> particleID;
+      std::vector<int> trackID;
+      std::vector<int> parentID;
+      std::vector<int> primaryID;
+      std::vector<int> channelID;
+
+      // Aggregated hit columns
+      std::vector<double> hitEntryPosX;
+      std::vector<double> hitEntryPosY;
+      std::vector<double> hitEntryPosZ;
+      std::vector<int> hitSteps;
+
+      inline void Clear();
+      void Grow(size_t capacity);
+    };
+
+    B1HitBuffer();
+    ~B1HitBuffer();
+
+    // Rewind all columns for a new event, O(1)
+    inline void Reset();
+
+    // Make room for the hits, avalanche electrons and clusters of this event
+    void Reserve(size_t nGasHits, size_t nPlateHits, size_t nAvalanche);
+
+    inline static void AppendHit(Stream& stream, G4int pID, G4int tID, G4int prntID,
+				 G4int primID, G4int channel, G4double t, G4double e);
+    inline static void AppendHitPos(Stream& stream, const G4ThreeVector& pos);
+    inline static void AppendHitEntry(Stream& stream,
+				      const G4ThreeVector& entryPos, G4int nSteps);
+    inline void AppendAvalanche(G4int primID, G4double energy);
+    inline void AppendCluster(G4int primID, G4int size);
+
+    inline void SetFinalEnergy(G4double value) { finalEnergy[0] = value; }
+    inline void CountLayer() { layerCount[0] += 1; }
+    inline void SetWeight(G4double value) { weight[0] = value; }
+
+    // Hit streams
+    Stream gas;
+    Stream plate;
+
+    // Per event columns, always one entry
+    std::vector<double> finalEnergy;
+    std::vector<int> avalancheSize;
+    std::vector<int> layerCount;
+    std::vector<double> weight;
+    std::vector<int> clusterCount;
+
+    std::vector<double> avalancheEnergy;
+    std::vector<int> avalanchePrimaryID;
+
+    // Primary clusters of the fast simulation of the gas
+    std::vector<int> clusterSize;
+    std::vector<int> clusterPrimaryID;
+
+  private:
+    size_t fGasHighWater;
+    size_t fPlateHighWater;
+    size_t fAvalancheHighWater;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1HitBuffer::Stream::Clear()
+{
+  // Clearing vectors of plain numbers does not release their storage
+  hitPosX.clear();
+  hitPosY.clear();
+  hitPosZ.clear();
+  time.clear();
+  energy.clear();
+  particleID.clear();
+  trackID.clear();
+  parentID.clear();
+  primaryID.clear();
+  channelID.clear();
+
+  hitEntryPosX.clear();
+  hitEntryPosY.clear();
+  hitEntryPosZ.clear();
+  hitSteps.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1HitBuffer::Reset()
+{
+  gas.Clear();
+  plate.Clear();
+
+  finalEnergy[0] = 0;
+  avalancheSize[0] = 0;
+  layerCount[0] = 0;
+  weight[0] = 1.;
+  clusterCount[0] = 0;
+
+  avalancheEnergy.clear();
+  avalanchePrimaryID.clear();
+  clusterSize.clear();
+  clusterPrimaryID.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1HitBuffer::AppendHit(Stream& stream, G4int pID, G4int tID, G4int prntID,
+				   G4int primID, G4int channel, G4double t, G4double e)
+{
+  stream.particleID.push_back(pID);
+  stream.trackID.push_back(tID);
+  stream.parentID.push_back(prntID);
+  stream.primaryID.push_back(primID);
+  stream.channelID.push_back(channel);
+  stream.time.push_back(t/ns);
+  stream.energy.push_back(e/MeV);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1HitBuffer::AppendHitPos(Stream& stream, const G4ThreeVector& pos)
+{
+  stream.hitPosX.push_back(pos.x()/mm);
+  stream.hitPosY.push_back(pos.y()/mm);
+  stream.hitPosZ.push_back(pos.z()/mm);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1HitBuffer::AppendHitEntry(Stream& stream,
+					const G4ThreeVector& entryPos, G4int nSteps)
+{
+  stream.hitEntryPosX.push_back(entryPos.x()/mm);
+  stream.hitEntryPosY.push_back(entryPos.y()/mm);
+  stream.hitEntryPosZ.push_back(entryPos.z()/mm);
+  stream.hitSteps.push_back(nSteps);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1HitBuffer::AppendAvalanche(G4int primID, G4double energy)
+{
+  avalancheSize[0] += 1;
+  avalancheEnergy.push_back(energy/MeV);
+  avalanchePrimaryID.push_back(primID);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1HitBuffer::AppendCluster(G4int primID, G4int size)
+{
+  clusterCount[0] += 1;
+  clusterSize.push_back(size);
+  clusterPrimaryID.push_back(primID);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
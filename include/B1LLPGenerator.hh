@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1LLPGenerator.hh
+/// \brief Definition of the B1LLPGenerator class
+
+#ifndef B1LLPGenerator_h
+#define B1LLPGenerator_h 1
+
+#include "G4VPrimaryGenerator.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4Event;
+class G4ParticleDefinition;
+
+/// Long-lived particle (LLP) signal generator, selected with
+/// /rpc/llp/enable.
+///
+/// A parent of given mass and proper lifetime leaves the interaction point
+/// (the origin, outside the cube) towards the fiducial box, the centre
+/// volume of the cube. Its momentum is drawn from a histogram, read from a
+/// local table of "pMin pMax weight" lines in GeV (/rpc/llp/spectrum); its
+/// direction is aimed at the box (B1AcceptanceBias), from the cone of the
+/// sphere around it or, from inside the sphere, from its faces; the
+/// directions missing the box are drawn again.
+/// The decay is forced on the chord of the box from the truncated
+/// exponential of the decay length, and the two daughters, isotropic in
+/// the rest frame, are the primaries of a single vertex.
+///
+/// The weight of the vertex is the probability of the decay within the
+/// chord times the isotropic density of the direction over its aimed
+/// density (the fraction of isotropic parents in the cone). Together
+/// with the directions drawn again, counted as trials by the run action,
+/// the sum of the weights over the trials is the fraction of the parents
+/// decaying in the box.
+
+class B1LLPGenerator : public G4VPrimaryGenerator
+{
+  public:
+    B1LLPGenerator();
+    virtual ~B1LLPGenerator();
+
+    // Adds the vertex of the daughters in the box of the half size set
+    // by SetFiducialHalfSize()
+    virtual void GeneratePrimaryVertex(G4Event* event);
+
+    void SetFiducialHalfSize(G4double halfSize) { fHalfSize = halfSize; }
+    G4int GetNofTrials() const { return fNofTrials; }
+
+    void SetMass(G4double mass) { fMass = mass; }
+    G4double GetMass() const { return fMass; }
+    void SetLifetime(G4double lifetime) { fLifetime = lifetime; }
+    void SetOrigin(const G4ThreeVector& origin) { fOrigin = origin; }
+    void SetDaughters(const G4String& name1, const G4String& name2);
+    // Momentum histogram of the parent, the default one for an empty name
+    void SetSpectrum(const G4String& fileName);
+
+  private:
+    G4double SampleMomentum() const;
+
+    G4double fMass;
+    G4double fLifetime;
+    G4ThreeVector fOrigin;
+    G4ParticleDefinition* fDaughter[2];
+    G4double fHalfSize;
+    G4int fNofTrials;
+
+    // Momentum bins and their cumulative probabilities
+    std::vector<G4double> fMomentumEdges;
+    std::vector<G4double> fCumulative;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1NavigationBenchmark.hh
+/// \brief Definition of the B1NavigationBenchmark class
+
+#ifndef B1NavigationBenchmark_h
+#define B1NavigationBenchmark_h 1
+
+#include "globals.hh"
+
+class G4VPhysicalVolume;
+
+/// Navigation benchmark
+///
+/// Times the navigator alone on the closed geometry: straight rays from
+/// random points on a sphere inside the world, aimed at random points of
+/// the central region, are stepped from boundary to boundary until they
+/// leave the world, with the maximum step of the user limits of each volume
+/// (the region step limit of the particles without their own limit), as a
+/// charged geantino would be transported. It prints the
+/// number of steps and boundary crossings, the steps per second and the
+/// navigator time per step, to compare the nested and flat layouts.
+
+class B1NavigationBenchmark
+{
+  public:
+    B1NavigationBenchmark(G4VPhysicalVolume* world);
+    ~B1NavigationBenchmark();
+
+    void Run(G4int nRays);
+
+  private:
+    G4VPhysicalVolume* fWorld;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,73 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1OverlapCache.hh
+/// \brief Definition of the B1OverlapCache class
+
+#ifndef B1OverlapCache_h
+#define B1OverlapCache_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+class G4VPhysicalVolume;
+
+/// Cache of the overlap check results.
+///
+/// The placed geometry (every physical volume in the store with its copy
+/// number, position, rotation, mother, material and solid parameters) is
+/// hashed after it has been built. The surface sampling check of the given
+/// placements is only run if the hash is not found in the cache file; the
+/// number of overlapping placements is then appended to the file with the
+/// hash. A geometry that was already checked starts without sampling, with
+/// the overlap warning again if it had overlaps, and a changed layout is
+/// checked again.
+
+class B1OverlapCache
+{
+  public:
+    B1OverlapCache(const G4String& fileName, G4int resolution = 1000);
+    ~B1OverlapCache();
+
+    // Number of overlapping placements, from the cache if possible
+    G4int Check(const std::vector<G4VPhysicalVolume*>& placements);
+
+    // Hash of the volumes in the physical volume store
+    uint64_t GeometryHash() const;
+
+  private:
+    G4bool Lookup(uint64_t hash, G4int& nOverlaps) const;
+    void Store(uint64_t hash, G4int nOverlaps) const;
+
+    G4String fFileName;
+    G4int fResolution;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
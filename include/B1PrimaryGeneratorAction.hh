@@ -37,16 +37,36 @@
 class G4ParticleGun;
 class G4Event;
 class G4Box;
+class B1RunAction;
+class B1CosmicMuonGenerator;
+class B1EventFileGenerator;
+class B1LLPGenerator;
+class B1PrimaryGeneratorMessenger;
 
 /// The primary generator action class with particle gun.
 ///
-/// The default kinematic is a 6 MeV gamma, randomly distribued 
-/// in front of the phantom across 80% of the (X,Y) phantom size.
+/// The default kinematic is a 10 GeV mu- from (0,0,-7 m) along +z. With
+/// /rpc/cosmic/enable the gun is set for each event by a
+/// B1CosmicMuonGenerator around the detector cube, and the live time of
+/// the muons is added to the run action. With /rpc/input/file the events
+/// are read from an external file by a B1EventFileGenerator instead.
+///
+/// /rpc/gun/isotropic throws the gun in all directions. With /rpc/bias/cone
+/// the directions of the isotropic gun and of the cosmic muons from the
+/// plane are aimed at the cube (B1AcceptanceBias), the importance sampling
+/// weight is set on the primary vertex. A gun inside the cube cannot be
+/// aimed and stays isotropic, with a warning. With
+/// /rpc/bias/veto the primaries that miss the cube are generated again
+/// before the event is transported, their live time is kept.
+///
+/// With /rpc/llp/enable the primaries are the daughters of a long-lived
+/// particle decaying in the centre volume (B1LLPGenerator), with the
+/// weight of the forced decay.
 
 class B1PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
-    B1PrimaryGeneratorAction();    
+    B1PrimaryGeneratorAction(B1RunAction* runAction);
     virtual ~B1PrimaryGeneratorAction();
 
     // method from the base class
@@ -54,10 +74,47 @@ class B1PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
   
     // method to access particle gun
     const G4ParticleGun* GetParticleGun() const { return fParticleGun; }
+
+    // Primaries of the active generator, for the run summary
+    G4String GetDescription() const;
+
+    // Cosmic muons in place of the fixed gun
+    void SetCosmic(G4bool value) { fCosmic = value; }
+    B1CosmicMuonGenerator* GetCosmicGenerator() { return fCosmicGenerator; }
+
+    // Events of an external file, before the gun and the cosmic muons
+    B1EventFileGenerator* GetEventFileGenerator() { return fEventFileGenerator; }
+
+    // Long-lived particle decays in place of the gun and the cosmic muons
+    void SetLLP(G4bool value) { fLLP = value; }
+    B1LLPGenerator* GetLLPGenerator() { return fLLPGenerator; }
+
+    // Acceptance biasing of the gun and of the cosmic muons
+    void SetIsotropic(G4bool value);
+    void SetConeBias(G4bool value) { fConeBias = value; }
+    void SetVeto(G4bool value) { fVeto = value; }
   
   private:
+    // Half sizes of the detector cube and of the world box
+    void GetHalfSizes(G4double& halfSize, G4double& worldHalfSize) const;
+    // Sets the gun for one trial, returns its live time and weight
+    G4double SampleGun(G4double halfSize, G4double worldHalfSize, G4double& weight);
+
     G4ParticleGun*  fParticleGun; // pointer a to G4 gun class
     G4Box* fEnvelopeBox;
+    B1RunAction* fRunAction;
+    G4bool fCosmic;
+    G4bool fIsotropic;
+    G4bool fConeBias;
+    G4bool fVeto;
+    G4bool fVetoWarned;
+    G4bool fConeWarned;
+    G4ThreeVector fGunDirection;   // restored when the gun is not isotropic
+    B1CosmicMuonGenerator* fCosmicGenerator;
+    B1EventFileGenerator* fEventFileGenerator;
+    G4bool fLLP;
+    B1LLPGenerator* fLLPGenerator;
+    B1PrimaryGeneratorMessenger* fMessenger;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,111 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PrimaryGeneratorMessenger.hh
+/// \brief Definition of the B1PrimaryGeneratorMessenger class
+
+#ifndef B1PrimaryGeneratorMessenger_h
+#define B1PrimaryGeneratorMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class B1PrimaryGeneratorAction;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWith3VectorAndUnit;
+
+/// Messenger class that defines commands for B1PrimaryGeneratorAction.
+///
+/// It implements commands:
+/// - /rpc/cosmic/enable true|false
+/// - /rpc/cosmic/surface plane|sphere
+/// - /rpc/cosmic/momentumRange pMin pMax unit
+/// - /rpc/cosmic/maxZenith value unit
+/// - /rpc/cosmic/chargeRatio value
+/// - /rpc/cosmic/planeHalfWidth value unit
+/// - /rpc/input/file fileName
+/// - /rpc/input/chunk nEvents
+/// - /rpc/gun/isotropic true|false
+/// - /rpc/bias/cone true|false
+/// - /rpc/bias/veto true|false
+/// - /rpc/llp/enable true|false
+/// - /rpc/llp/mass value unit
+/// - /rpc/llp/lifetime value unit
+/// - /rpc/llp/origin x y z unit
+/// - /rpc/llp/daughters name1 name2
+/// - /rpc/llp/spectrum fileName
+
+class B1PrimaryGeneratorMessenger: public G4UImessenger
+{
+  public:
+    B1PrimaryGeneratorMessenger(B1PrimaryGeneratorAction* );
+    virtual ~B1PrimaryGeneratorMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1PrimaryGeneratorAction*  fPrimaryGeneratorAction;
+
+    G4UIdirectory*             fCosmicDirectory;
+
+    G4UIcmdWithABool*          fEnableCmd;
+    G4UIcmdWithAString*        fSurfaceCmd;
+    G4UIcommand*               fMomentumRangeCmd;
+    G4UIcmdWithADoubleAndUnit* fMaxZenithCmd;
+    G4UIcmdWithADouble*        fChargeRatioCmd;
+    G4UIcmdWithADoubleAndUnit* fPlaneHalfWidthCmd;
+
+    G4UIdirectory*             fInputDirectory;
+
+    G4UIcmdWithAString*        fInputFileCmd;
+    G4UIcmdWithAnInteger*      fChunkCmd;
+
+    G4UIdirectory*             fGunDirectory;
+    G4UIdirectory*             fBiasDirectory;
+
+    G4UIcmdWithABool*          fIsotropicCmd;
+    G4UIcmdWithABool*          fConeCmd;
+    G4UIcmdWithABool*          fVetoCmd;
+
+    G4UIdirectory*             fLLPDirectory;
+
+    G4UIcmdWithABool*          fLLPEnableCmd;
+    G4UIcmdWithADoubleAndUnit* fMassCmd;
+    G4UIcmdWithADoubleAndUnit* fLifetimeCmd;
+    G4UIcmdWith3VectorAndUnit* fOriginCmd;
+    G4UIcommand*               fDaughtersCmd;
+    G4UIcmdWithAString*        fSpectrumCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
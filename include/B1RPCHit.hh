@@ -0,0 +1,137 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RPCHit.hh
+/// \brief Definition of the B1RPCHit class
+
+#ifndef B1RPCHit_h
+#define B1RPCHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "G4ThreeVector.hh"
+#include "tls.hh"
+
+#include "B1VolumeRoles.hh"
+
+/// RPC hit class
+///
+/// It defines data members to store the type of the hit (gas or plate), the
+/// particle ID, track ID, parent ID and primary ancestor of the particle,
+/// the packed channel ID of the cell (see B1ChannelID), the position and
+/// time of the hit, and its energy: the change in kinetic
+/// energy of the particle for gas hits, the energy deposit for plate hits.
+///
+/// When hits are aggregated, one hit holds all consecutive steps of a track
+/// in the same cell: the entry and exit positions, the time of the first
+/// step, the summed energy and the number of steps merged.
+
+class B1RPCHit : public G4VHit
+{
+  public:
+    B1RPCHit();
+    B1RPCHit(const B1RPCHit&);
+    virtual ~B1RPCHit();
+
+    // operators
+    const B1RPCHit& operator=(const B1RPCHit&);
+    G4int operator==(const B1RPCHit&) const;
+
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+
+    // methods from base class
+    virtual void Print();
+
+    // Set methods
+    void SetType(B1VolumeRole type) { fType = type; };
+    void SetParticleID(G4int id) { fParticleID = id; };
+    void SetTrackID(G4int id)    { fTrackID = id; };
+    void SetParentID(G4int id)   { fParentID = id; };
+    void SetPrimaryID(G4int id)  { fPrimaryID = id; };
+    void SetChannelID(G4int id)  { fChannelID = id; };
+    void SetEntryPos(G4ThreeVector xyz) { fEntryPos = xyz; };
+    void SetPos(G4ThreeVector xyz) { fPos = xyz; };
+    void SetTime(G4double time)  { fTime = time; };
+    void SetEnergy(G4double e)   { fEnergy = e; };
+
+    // Add a further step of the same track in the same cell
+    void AddStep(G4ThreeVector xyz, G4double e)
+    { fPos = xyz; fEnergy += e; fNofSteps++; };
+
+    // Get methods
+    B1VolumeRole GetType() const { return fType; };
+    G4int GetParticleID() const  { return fParticleID; };
+    G4int GetTrackID() const     { return fTrackID; };
+    G4int GetParentID() const    { return fParentID; };
+    G4int GetPrimaryID() const   { return fPrimaryID; };
+    G4int GetChannelID() const   { return fChannelID; };
+    G4ThreeVector GetEntryPos() const { return fEntryPos; };
+    G4ThreeVector GetPos() const { return fPos; };
+    G4double GetTime() const     { return fTime; };
+    G4double GetEnergy() const   { return fEnergy; };
+    G4int GetNofSteps() const    { return fNofSteps; };
+
+  private:
+    B1VolumeRole  fType;
+    G4int         fParticleID;
+    G4int         fTrackID;
+    G4int         fParentID;
+    G4int         fPrimaryID;
+    G4int         fChannelID;
+    G4ThreeVector fEntryPos;
+    G4ThreeVector fPos;
+    G4double      fTime;
+    G4double      fEnergy;
+    G4int         fNofSteps;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+typedef G4THitsCollection<B1RPCHit> B1RPCHitsCollection;
+
+extern G4ThreadLocal G4Allocator<B1RPCHit>* B1RPCHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* B1RPCHit::operator new(size_t)
+{
+  if(!B1RPCHitAllocator)
+      B1RPCHitAllocator = new G4Allocator<B1RPCHit>;
+  return (void *) B1RPCHitAllocator->MallocSingle();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1RPCHit::operator delete(void *hit)
+{
+  B1RPCHitAllocator->FreeSingle((B1RPCHit*) hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
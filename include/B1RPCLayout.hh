@@ -0,0 +1,183 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RPCLayout.hh
+/// \brief Definition of the B1RPCLayout class
+
+#ifndef B1RPCLayout_h
+#define B1RPCLayout_h 1
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// Layout of the RPC layers of the CODEX-b cube.
+///
+/// Six faces of nFaceLayers RPCs surround the cube, the centre volume holds
+/// nCentreGroups equally spaced groups of nPerCentreGroup RPCs along z. An
+/// RPC is a gas gap between two plates. The lengths are in mm, the Geant4
+/// internal unit, so that B1DetectorConstruction and the standalone
+/// acceptance engine (tools/acceptance) place the layers with the same
+/// parameters and formulae. Like B1ChannelID, this header only depends on
+/// the standard library.
+///
+/// The layout of a simulation can be written with /rpc/geometry/writeLayout
+/// and read back by the acceptance engine.
+
+class B1RPCLayout
+{
+  public:
+    double detSize = 10000.;     // side of the cube and of the layers
+    double gasThick = 1.;
+    double plateThick = 1.2;
+    double padSizeX = 2000.;
+    double padSizeY = 1000.;
+    double layerSep = 40.;       // from surface of one layer to surface of the next
+    int nFaceLayers = 6;
+    int nPerCentreGroup = 3;
+    int nCentreGroups = 5;
+
+    // Defaults of the full CODEX-b cube ("codexb") or of the demonstrator
+    static B1RPCLayout Model(const std::string& model)
+    {
+      B1RPCLayout layout;
+      if(model != "codexb")
+	{
+	  layout.detSize = 2000.;
+	  layout.nFaceLayers = 3;
+	  layout.nPerCentreGroup = 3;
+	  layout.nCentreGroups = 1;
+	}
+      return layout;
+    }
+
+    double RPCThickness() const { return 2*plateThick + gasThick; }
+    double StackThickness(int nLayers) const
+    { return nLayers*RPCThickness() + (nLayers - 1)*layerSep; }
+    double FaceThickness() const  { return StackThickness(nFaceLayers); }
+    double GroupThickness() const { return StackThickness(nPerCentreGroup); }
+
+    // Centre of an RPC layer in its face or group, along its local z
+    double LayerZ(double stackThick, int nLayer) const
+    { return -0.5*stackThick + 0.5*RPCThickness() + nLayer*(RPCThickness() + layerSep); }
+
+    // Distance of the face centres from the cube centre
+    double FaceOffset() const { return 0.5*detSize + 0.5*FaceThickness(); }
+
+    // Centre of a group along z, equal spacing along the cube
+    double GroupZ(int nGroup) const
+    {
+      double groupSep = (detSize - nCentreGroups*GroupThickness())/(nCentreGroups + 1);
+      return -0.5*detSize + groupSep + 0.5*GroupThickness()
+	+ nGroup*(GroupThickness() + groupSep);
+    }
+
+    // Axis aligned box of a gas gap, with its station (B1ChannelID
+    // numbering: faces -z, +z, -x, +x, -y, +y, then the groups) and layer
+    struct Slab
+    {
+      double min[3];
+      double max[3];
+      unsigned int station;
+      unsigned int layer;
+    };
+
+    // Gas gaps of all layers, station by station. The faces on the x axis
+    // are rotated so that their local z points along -x, those on the y
+    // axis so that it points along +y.
+    std::vector<Slab> GasSlabs() const
+    {
+      std::vector<Slab> slabs;
+      const int kAxis[6] = { 2, 2, 0, 0, 1, 1 };
+      const double kSide[6] = { -1, 1, -1, 1, -1, 1 };
+      const double kLocalZ[6] = { 1, 1, -1, -1, 1, 1 };
+      for(int face=0; face<6; face++)
+	for(int layer=0; layer<nFaceLayers; layer++)
+	  slabs.push_back(MakeSlab(kAxis[face],
+				   kSide[face]*FaceOffset()
+				   + kLocalZ[face]*LayerZ(FaceThickness(), layer),
+				   face, layer));
+      for(int group=0; group<nCentreGroups; group++)
+	for(int layer=0; layer<nPerCentreGroup; layer++)
+	  slabs.push_back(MakeSlab(2, GroupZ(group) + LayerZ(GroupThickness(), layer),
+				   6 + group, layer));
+      return slabs;
+    }
+
+    void Write(std::ostream& os) const
+    {
+      os << "detSize " << detSize << "\n"
+	 << "gasThick " << gasThick << "\n"
+	 << "plateThick " << plateThick << "\n"
+	 << "padSizeX " << padSizeX << "\n"
+	 << "padSizeY " << padSizeY << "\n"
+	 << "layerSep " << layerSep << "\n"
+	 << "nFaceLayers " << nFaceLayers << "\n"
+	 << "nPerCentreGroup " << nPerCentreGroup << "\n"
+	 << "nCentreGroups " << nCentreGroups << "\n";
+    }
+
+    // Reads the "name value" lines of Write(), unknown names are an error
+    bool Read(std::istream& is)
+    {
+      std::string name;
+      while(is >> name)
+	{
+	  if(name == "detSize") is >> detSize;
+	  else if(name == "gasThick") is >> gasThick;
+	  else if(name == "plateThick") is >> plateThick;
+	  else if(name == "padSizeX") is >> padSizeX;
+	  else if(name == "padSizeY") is >> padSizeY;
+	  else if(name == "layerSep") is >> layerSep;
+	  else if(name == "nFaceLayers") is >> nFaceLayers;
+	  else if(name == "nPerCentreGroup") is >> nPerCentreGroup;
+	  else if(name == "nCentreGroups") is >> nCentreGroups;
+	  else return false;
+	}
+      return true;
+    }
+
+  private:
+    Slab MakeSlab(int axis, double centre, unsigned int station, unsigned int layer) const
+    {
+      Slab slab;
+      for(int i=0; i<3; i++)
+	{
+	  slab.min[i] = -0.5*detSize;
+	  slab.max[i] = 0.5*detSize;
+	}
+      slab.min[axis] = centre - 0.5*gasThick;
+      slab.max[axis] = centre + 0.5*gasThick;
+      slab.station = station;
+      slab.layer = layer;
+      return slab;
+    }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RPCSensitiveDetector.hh
+/// \brief Definition of the B1RPCSensitiveDetector class
+
+#ifndef B1RPCSensitiveDetector_h
+#define B1RPCSensitiveDetector_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+#include "B1RPCHit.hh"
+#include "B1GasCrossingHit.hh"
+#include "B1VolumeRoles.hh"
+
+class G4Step;
+class G4Track;
+class G4HCofThisEvent;
+class G4VTouchable;
+class B1DetectorConstruction;
+
+/// RPC sensitive detector class
+///
+/// One instance is attached to the gas cells and one to the plates. Every
+/// step with a change in kinetic energy (gas) or an energy deposit (plates)
+/// creates a B1RPCHit of the detector's type in its "Hits" collection. The
+/// gas detector also fills a "Crossings" collection of B1GasCrossingHit,
+/// for primary particles and avalanche electrons leaving a gas cell.
+///
+/// With hit aggregation switched on (/rpc/readout/aggregate), the steps of
+/// a track from its entry into a cell until it leaves the cell are merged
+/// into a single hit.
+///
+/// The packed channel ID of a hit (B1ChannelID) is decoded from the
+/// touchable history when the hit is created: pad and strip replicas, the
+/// gas or plate envelope, the RPC layer and the face or centre group. In the
+/// flat layout it is the copy number of the pad and its face or group.
+///
+/// Only the hits and crossings of the outputs selected in the run action
+/// (/rpc/output/...) are created.
+///
+/// When the gas gap is simulated by B1GasFastSimModel, the model stores its
+/// clusters and crossings through the fast methods and the steps of the
+/// fast simulation are skipped. Its primary clusters are stored with the
+/// avalanche output but kept apart from the avalanche electrons.
+
+class B1RPCSensitiveDetector : public G4VSensitiveDetector
+{
+  public:
+    B1RPCSensitiveDetector(const G4String& name, B1VolumeRole role,
+			   const B1DetectorConstruction* detector);
+    virtual ~B1RPCSensitiveDetector();
+
+    // methods from base class
+    virtual void   Initialize(G4HCofThisEvent* hitCollection);
+    virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory* history);
+
+    // Detector of the plates, avalanche electrons are counted when reaching it
+    void SetPlateDetector(const G4VSensitiveDetector* plateSD) { fPlateDetector = plateSD; }
+
+    // Hits and crossings of a track simulated by the fast model of the gas
+    void StartFastCrossing(const G4Track* track, const G4ThreeVector& entryPos);
+    void AddFastHit(const G4Track* track, const G4VTouchable* touchable,
+		    const G4ThreeVector& pos, G4double time, G4double energy);
+    void AddFastCluster(const G4Track* track, G4int size, G4double energy);
+    void AddFastCrossing(const G4Track* track);
+
+  private:
+    void AddHit(const G4Track* track, const G4VTouchable* touchable,
+		const G4ThreeVector& prePos, const G4ThreeVector& pos,
+		G4double time, G4double energy);
+    void AddCrossing(G4int trackID, G4int parentID, G4int primaryID,
+		     G4double vertexEnergy, G4bool avalanche, G4int clusterSize = 0);
+    G4int ChannelID(const G4VTouchable* touchable) const;
+
+    B1VolumeRole fRole;
+    const B1DetectorConstruction* fDetector;
+    const G4VSensitiveDetector* fPlateDetector;
+
+    // Output selection of the run
+    G4bool fOutputHits;
+    G4bool fOutputAvalanche;
+    G4bool fOutputPrimary;
+
+    // Hit aggregation state
+    G4bool fAggregate;
+    G4int fCurrentTrackID;
+    B1RPCHit* fCurrentHit;
+    G4ThreeVector fEntryPos;
+
+    // Track last simulated by the fast model
+    G4int fFastTrackID;
+
+    B1RPCHitsCollection* fHitsCollection;
+    B1GasCrossingHitsCollection* fCrossingsCollection;
+    G4int fHitsCollectionID;
+    G4int fCrossingsCollectionID;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
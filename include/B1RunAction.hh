@@ -32,17 +32,33 @@
 
 #include "G4UserRunAction.hh"
 #include "G4Accumulable.hh"
+#include "G4Timer.hh"
 #include "globals.hh"
 
-#include <vector>
+#include "B1HitBuffer.hh"
+#include "B1FieldTrackMode.hh"
 
 class G4Run;
+class B1RunMessenger;
+class B1DetectorConstruction;
 
 /// Run action class
 ///
-/// In EndOfRunAction(), it calculates the dose in the selected volume 
-/// from the energy deposit accumulated via stepping and event actions.
-/// The computed dose is then printed on the screen.
+/// It books the output ntuple at the first run and writes it at the end of
+/// each run. In EndOfRunAction(), it prints the run conditions: the active
+/// primary generator, the gas field and the output file.
+///
+/// The run is also timed, and the number of steps taken is accumulated from
+/// the tracking action so that the stepping rate can be printed at the end
+/// of the run, with the live time of the cosmic muons when they are
+/// generated and the tracks through the gas field per propagation mode
+/// (B1GasFieldManager).
+///
+/// The outputs written can be selected at runtime (/rpc/output/...). When
+/// only the primary particle observables are requested, the other user
+/// actions skip the hits and secondaries are not tracked. The columns are
+/// booked at the first run, the selection and the hit aggregation of the
+/// booking are kept for the later runs.
 
 class B1RunAction : public G4UserRunAction
 {
@@ -54,25 +70,52 @@ class B1RunAction : public G4UserRunAction
     virtual void BeginOfRunAction(const G4Run*);
     virtual void   EndOfRunAction(const G4Run*);
 
-    std::vector<double> hitPosX;
-    std::vector<double> hitPosY;
-    std::vector<double> hitPosZ;
-    std::vector<double> edep;
-    std::vector<double> time;
-    std::vector<double> deltaEnergy;
-    std::vector<int> particleID;
-    std::vector<int> trackID;
-    std::vector<int> parentID;
+    void AddSteps(G4int nSteps) { fNofSteps += nSteps; }
+    void AddLiveTime(G4double time) { fLiveTime += time; }
+    void AddPrimary(G4int nTrials, G4double weight)
+    { fPrimaryTrials += nTrials; fPrimaryWeight += weight; }
+    void CountFieldTrack(B1FieldTrackMode mode) { fFieldTracks[mode] += 1; }
 
-    std::vector<double> finalEnergy;
+    // Output selection
+    void SetOutputHits(G4bool value) { fOutputHits = value; }
+    void SetOutputAvalanche(G4bool value) { fOutputAvalanche = value; }
+    void SetOutputPrimary(G4bool value) { fOutputPrimary = value; }
+    void SetOutputPositions(G4bool value) { fOutputPositions = value; }
+    G4bool GetOutputHits() const { return fOutputHits; }
+    G4bool GetOutputAvalanche() const { return fOutputAvalanche; }
+    G4bool GetOutputPrimary() const { return fOutputPrimary; }
+    G4bool GetOutputPositions() const { return fOutputPositions; }
+    G4bool IsPrimaryOnly() const { return !fOutputHits && !fOutputAvalanche; }
 
-    std::vector<int> avalancheSize;
-    std::vector<double> avalancheEnergy;
+    // Output file of the next run
+    void SetOutputFile(const G4String& fileName) { fOutputFile = fileName; }
 
-    std::vector<int> layerCount;
+    // Ntuple columns of this thread
+    B1HitBuffer hits;
+    G4bool aggregateHits = false;
 
   private:
-  
+    void BookNtuple();
+    void KeepBookedOutputs(const B1DetectorConstruction* detector);
+    void BookHitStream(const G4String& prefix, const G4String& energyName,
+		       B1HitBuffer::Stream& stream);
+
+    G4Accumulable<G4double> fNofSteps;
+    G4Accumulable<G4double> fLiveTime;   // of the cosmic muons
+    G4Accumulable<G4double> fPrimaryTrials;   // generated before the veto
+    G4Accumulable<G4double> fPrimaryWeight;   // sum of the event weights
+    G4Accumulable<G4int> fFieldTracks[3];   // integrated, coarse, straight
+    G4Timer fTimer;
+
+    G4bool fOutputHits;
+    G4bool fOutputAvalanche;
+    G4bool fOutputPrimary;
+    G4bool fOutputPositions;
+    G4bool fNtupleBooked;
+    G4bool fBookedOutputs[4];   // hits, avalanche, primary, positions
+    G4String fOutputFile;
+
+    B1RunMessenger* fMessenger;
 };
 
 #endif
@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RunMessenger.hh
+/// \brief Definition of the B1RunMessenger class
+
+#ifndef B1RunMessenger_h
+#define B1RunMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class B1RunAction;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+
+/// Messenger class that defines commands for B1RunAction.
+///
+/// It implements commands:
+/// - /rpc/output/hits true|false
+/// - /rpc/output/avalanche true|false
+/// - /rpc/output/primary true|false
+/// - /rpc/output/positions true|false
+/// - /rpc/output/file fileName
+
+class B1RunMessenger: public G4UImessenger
+{
+  public:
+    B1RunMessenger(B1RunAction* );
+    virtual ~B1RunMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1RunAction*             fRunAction;
+
+    G4UIdirectory*           fOutputDirectory;
+
+    G4UIcmdWithABool*        fHitsCmd;
+    G4UIcmdWithABool*        fAvalancheCmd;
+    G4UIcmdWithABool*        fPrimaryCmd;
+    G4UIcmdWithABool*        fPositionsCmd;
+    G4UIcmdWithAString*      fFileCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
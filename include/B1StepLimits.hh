@@ -0,0 +1,64 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepLimits.hh
+/// \brief Definition of the B1StepLimits class
+
+#ifndef B1StepLimits_h
+#define B1StepLimits_h 1
+
+#include "G4UserLimits.hh"
+#include "globals.hh"
+
+#include <utility>
+#include <vector>
+
+class G4ParticleDefinition;
+
+/// User limits with a maximum step per particle type
+///
+/// The maximum step set with SetMaxAllowedStep(G4double) applies to the
+/// particles without their own limit. The limits are applied by the step
+/// limiter process, which is only registered for charged particles.
+
+class B1StepLimits : public G4UserLimits
+{
+  public:
+    B1StepLimits(const G4String& type);
+    virtual ~B1StepLimits();
+
+    using G4UserLimits::SetMaxAllowedStep;
+    void SetMaxAllowedStep(const G4ParticleDefinition* particle, G4double maxStep);
+
+    virtual G4double GetMaxAllowedStep(const G4Track& track);
+
+  private:
+    std::vector<std::pair<const G4ParticleDefinition*, G4double>> fParticleMaxSteps;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
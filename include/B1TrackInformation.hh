@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackInformation.hh
+/// \brief Definition of the B1TrackInformation class
+
+#ifndef B1TrackInformation_h
+#define B1TrackInformation_h 1
+
+#include "G4VUserTrackInformation.hh"
+#include "G4Allocator.hh"
+#include "globals.hh"
+
+#include "B1VolumeRoles.hh"
+
+/// Track information class
+///
+/// Filled once when the track is created: the role of the volume the track
+/// was produced in, its generation (0 for primaries) and the track ID of its
+/// primary ancestor. Avalanche electrons are flagged here, so the sensitive
+/// detectors do not need to look up the origin volume at every step.
+
+class B1TrackInformation : public G4VUserTrackInformation
+{
+  public:
+    B1TrackInformation(B1VolumeRole originRole, G4int generation,
+		       G4int primaryID, G4bool electron);
+    virtual ~B1TrackInformation();
+
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+
+    virtual void Print() const;
+
+    B1VolumeRole GetOriginRole() const { return fOriginRole; }
+    G4int GetGeneration() const { return fGeneration; }
+    G4int GetPrimaryID() const { return fPrimaryID; }
+
+    // Electron produced in the gas, counted in the avalanche if it reaches a plate
+    G4bool IsGasElectron() const { return fGasElectron; }
+
+  private:
+    B1VolumeRole fOriginRole;
+    G4int fGeneration;
+    G4int fPrimaryID;
+    G4bool fGasElectron;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+extern G4ThreadLocal G4Allocator<B1TrackInformation>* B1TrackInformationAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* B1TrackInformation::operator new(size_t)
+{
+  if(!B1TrackInformationAllocator)
+    B1TrackInformationAllocator = new G4Allocator<B1TrackInformation>;
+  return (void*) B1TrackInformationAllocator->MallocSingle();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1TrackInformation::operator delete(void* info)
+{
+  B1TrackInformationAllocator->FreeSingle((B1TrackInformation*) info);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
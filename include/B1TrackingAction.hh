@@ -0,0 +1,67 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackingAction.hh
+/// \brief Definition of the B1TrackingAction class
+
+#ifndef B1TrackingAction_h
+#define B1TrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+#include "B1VolumeRoles.hh"
+
+class B1RunAction;
+class B1EventAction;
+
+/// Tracking action class
+///
+/// Adds the number of steps of each finished track to the run, which gives
+/// the stepping rate without a per-step user hook, and passes the final
+/// energy of the primary particle to the event action.
+///
+/// It also attaches a B1TrackInformation to every track: primaries get
+/// theirs when they start, secondaries when their parent finishes.
+
+class B1TrackingAction : public G4UserTrackingAction
+{
+  public:
+    B1TrackingAction(B1RunAction* runAction, B1EventAction* eventAction);
+    virtual ~B1TrackingAction();
+
+    virtual void PreUserTrackingAction(const G4Track*);
+    virtual void PostUserTrackingAction(const G4Track*);
+
+  private:
+    const B1VolumeRoles* fVolumeRoles;
+    B1RunAction* fRunAction;
+    B1EventAction* fEventAction;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
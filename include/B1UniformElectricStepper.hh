@@ -0,0 +1,99 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+//
+/// \file B1UniformElectricStepper.hh
+/// \brief Definition of the B1UniformElectricStepper class
+
+#ifndef B1UniformElectricStepper_h
+#define B1UniformElectricStepper_h 1
+
+#include "G4MagIntegratorStepper.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class B1EqElectricField;
+
+/// Stepper using the exact relativistic trajectory in a uniform electric
+/// field, selected with stepper type 10 of B1ElectricFieldSetup.
+///
+/// The momentum is split along the force and across it. The transverse
+/// energy E_T = sqrt(m^2 + pT^2) is conserved, and with the rapidity eta
+/// along the force, p_par = E_T sinh(eta) and E = E_T cosh(eta), the
+/// trajectory is (F = |qE|)
+///   x_par = E_T/F (cosh(eta) - cosh(eta0)),  x_T = pT/F (eta - eta0),
+///   c t   = E_T/F (sinh(eta) - sinh(eta0)).
+/// The path length s(eta) = 1/F int |p| d(eta) has no closed form; it is
+/// integrated by adaptive Gauss-Legendre quadrature and the step length
+/// solved for eta with a safeguarded Newton iteration, to a relative
+/// precision of 1e-12. The error estimate is therefore zero, and the
+/// driver takes the longest steps it allows.
+///
+/// The field is taken at the start of the step, so the stepper is only
+/// exact for uniform fields.
+
+class B1UniformElectricStepper : public G4MagIntegratorStepper
+{
+  public:
+    B1UniformElectricStepper(B1EqElectricField* equation, G4int nvar = 8);
+    virtual ~B1UniformElectricStepper();
+
+    virtual void Stepper(const G4double y[], const G4double dydx[], G4double h,
+			 G4double yout[], G4double yerr[]);
+    virtual G4double DistChord() const;
+    // The order only sets how fast the driver grows the steps
+    virtual G4int IntegratorOrder() const { return 4; }
+
+  private:
+    // Momentum at rapidity eta0 + deta, and its integral over deta
+    G4double Momentum(G4double deta) const;
+    G4double Integral(G4double deta0, G4double deta1) const;
+    G4double AdaptiveIntegral(G4double deta0, G4double deta1, G4double whole,
+			      G4double tolerance, G4int depth) const;
+    // Displacement along and across the force after deta
+    G4ThreeVector Displacement(G4double deta) const;
+
+    B1EqElectricField* fEquation;
+
+    // Trajectory of the last step
+    G4ThreeVector fForceDir;
+    G4ThreeVector fMomT;
+    G4double fForce;
+    G4double fMomT2;
+    G4double fEnergyT;
+    G4double fSinh0;
+    G4double fCosh0;
+
+    // Start, middle and end points of the last step, for DistChord()
+    G4ThreeVector fStartPoint;
+    G4ThreeVector fMidPoint;
+    G4ThreeVector fEndPoint;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1VolumeRoles.hh
+/// \brief Definition of the B1VolumeRoles class
+
+#ifndef B1VolumeRoles_h
+#define B1VolumeRoles_h 1
+
+#include "globals.hh"
+
+#include <utility>
+#include <vector>
+
+class G4LogicalVolume;
+
+/// Role of a logical volume in the RPC readout
+enum B1VolumeRole
+{
+  kRoleOther = 0,
+  kRoleGas,
+  kRolePlate,
+  kRoleEnvelope
+};
+
+/// Logical volume to role lookup table.
+///
+/// The table is built once at the start of each run from the logical volume
+/// store, so that user actions can test volume roles with a pointer compare
+/// instead of comparing volume names on every step. One table exists per
+/// thread.
+
+class B1VolumeRoles
+{
+  public:
+    static B1VolumeRoles* Instance();
+
+    // Rebuild the table from the current logical volume store
+    void Build();
+
+    inline B1VolumeRole GetRole(const G4LogicalVolume* volume) const;
+
+  private:
+    B1VolumeRoles();
+    ~B1VolumeRoles();
+
+    static B1VolumeRole RoleFromName(const G4String& name);
+
+    std::vector<std::pair<const G4LogicalVolume*, B1VolumeRole> > fTable;
+
+    // Last lookup, successive steps are usually in the same volume
+    mutable const G4LogicalVolume* fLastVolume;
+    mutable B1VolumeRole fLastRole;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline B1VolumeRole B1VolumeRoles::GetRole(const G4LogicalVolume* volume) const
+{
+  if(volume == fLastVolume) return fLastRole;
+
+  B1VolumeRole role = kRoleOther;
+  for(const auto& entry : fTable)
+    {
+      if(entry.first == volume)
+	{
+	  role = entry.second;
+	  break;
+	}
+    }
+  fLastVolume = volume;
+  fLastRole = role;
+  return role;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
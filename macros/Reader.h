@@ -24,32 +24,64 @@ public :
 // Fixed size dimensions of array or collections stored in the TTree if any.
 
    // Declaration of leaf types
-   std::vector<double>  *EnergyDeposition;
+   std::vector<int>     *GasParticleID;
+   std::vector<int>     *GasTrackID;
+   std::vector<int>     *GasParentID;
+   std::vector<int>     *GasPrimaryID;
+   std::vector<int>     *GasChannelID;
+   std::vector<double>  *GasHitPosX;
+   std::vector<double>  *GasHitPosY;
+   std::vector<double>  *GasHitPosZ;
+   std::vector<double>  *GasTime;
    std::vector<double>  *GasDeltaEnergy;
-   std::vector<int>     *ParticleID;
-   std::vector<int>     *TrackID;
-   std::vector<int>     *ParentID;
-   std::vector<double>  *HitPosX;
-   std::vector<double>  *HitPosY;
-   std::vector<double>  *HitPosZ;
-   std::vector<double>  *Time;
-   std::vector<double>  *EnergyLoss;
+   std::vector<int>     *PlateParticleID;
+   std::vector<int>     *PlateTrackID;
+   std::vector<int>     *PlateParentID;
+   std::vector<int>     *PlatePrimaryID;
+   std::vector<int>     *PlateChannelID;
+   std::vector<double>  *PlateHitPosX;
+   std::vector<double>  *PlateHitPosY;
+   std::vector<double>  *PlateHitPosZ;
+   std::vector<double>  *PlateTime;
+   std::vector<double>  *PlateEnergyDeposition;
+   std::vector<double>  *FinalEnergy;
    std::vector<int>     *AvalancheSize;
    std::vector<double>  *AvalancheEnergy;
+   std::vector<int>     *AvalanchePrimaryID;
+   std::vector<int>     *ClusterCount;
+   std::vector<int>     *ClusterSize;
+   std::vector<int>     *ClusterPrimaryID;
+   std::vector<int>     *LayerCount;
 
    // List of branches
-   TBranch        *b_EnergyDeposition;   //!
+   TBranch        *b_GasParticleID;   //!
+   TBranch        *b_GasTrackID;   //!
+   TBranch        *b_GasParentID;   //!
+   TBranch        *b_GasPrimaryID;   //!
+   TBranch        *b_GasChannelID;   //!
+   TBranch        *b_GasHitPosX;   //!
+   TBranch        *b_GasHitPosY;   //!
+   TBranch        *b_GasHitPosZ;   //!
+   TBranch        *b_GasTime;   //!
    TBranch        *b_GasDeltaEnergy;   //!
-   TBranch        *b_ParticleID;   //!
-   TBranch        *b_TrackID;   //!
-   TBranch        *b_ParentID;   //!
-   TBranch        *b_HitPosX;   //!
-   TBranch        *b_HitPosY;   //!
-   TBranch        *b_HitPosZ;   //!
-   TBranch        *b_Time;   //!
-   TBranch        *b_EnergyLoss;   //!
+   TBranch        *b_PlateParticleID;   //!
+   TBranch        *b_PlateTrackID;   //!
+   TBranch        *b_PlateParentID;   //!
+   TBranch        *b_PlatePrimaryID;   //!
+   TBranch        *b_PlateChannelID;   //!
+   TBranch        *b_PlateHitPosX;   //!
+   TBranch        *b_PlateHitPosY;   //!
+   TBranch        *b_PlateHitPosZ;   //!
+   TBranch        *b_PlateTime;   //!
+   TBranch        *b_PlateEnergyDeposition;   //!
+   TBranch        *b_FinalEnergy;   //!
    TBranch        *b_AvalancheSize;   //!
    TBranch        *b_AvalancheEnergy;   //!
+   TBranch        *b_AvalanchePrimaryID;   //!
+   TBranch        *b_ClusterCount;   //!
+   TBranch        *b_ClusterSize;   //!
+   TBranch        *b_ClusterPrimaryID;   //!
+   TBranch        *b_LayerCount;   //!
 
    Reader(TTree *tree=0);
    virtual ~Reader();
@@ -116,36 +148,68 @@ void Reader::Init(TTree *tree)
    // (once per file to be processed).
 
    // Set object pointer
-   EnergyDeposition = 0;
+   GasParticleID = 0;
+   GasTrackID = 0;
+   GasParentID = 0;
+   GasPrimaryID = 0;
+   GasChannelID = 0;
+   GasHitPosX = 0;
+   GasHitPosY = 0;
+   GasHitPosZ = 0;
+   GasTime = 0;
    GasDeltaEnergy = 0;
-   ParticleID = 0;
-   TrackID = 0;
-   ParentID = 0;
-   HitPosX = 0;
-   HitPosY = 0;
-   HitPosZ = 0;
-   Time = 0;
-   EnergyLoss = 0;
+   PlateParticleID = 0;
+   PlateTrackID = 0;
+   PlateParentID = 0;
+   PlatePrimaryID = 0;
+   PlateChannelID = 0;
+   PlateHitPosX = 0;
+   PlateHitPosY = 0;
+   PlateHitPosZ = 0;
+   PlateTime = 0;
+   PlateEnergyDeposition = 0;
+   FinalEnergy = 0;
    AvalancheSize = 0;
    AvalancheEnergy = 0;
+   AvalanchePrimaryID = 0;
+   ClusterCount = 0;
+   ClusterSize = 0;
+   ClusterPrimaryID = 0;
+   LayerCount = 0;
    // Set branch addresses and branch pointers
    if (!tree) return;
    fChain = tree;
    fCurrent = -1;
    fChain->SetMakeClass(1);
 
-   fChain->SetBranchAddress("EnergyDeposition", &EnergyDeposition, &b_EnergyDeposition);
+   fChain->SetBranchAddress("GasParticleID", &GasParticleID, &b_GasParticleID);
+   fChain->SetBranchAddress("GasTrackID", &GasTrackID, &b_GasTrackID);
+   fChain->SetBranchAddress("GasParentID", &GasParentID, &b_GasParentID);
+   fChain->SetBranchAddress("GasPrimaryID", &GasPrimaryID, &b_GasPrimaryID);
+   fChain->SetBranchAddress("GasChannelID", &GasChannelID, &b_GasChannelID);
+   fChain->SetBranchAddress("GasHitPosX", &GasHitPosX, &b_GasHitPosX);
+   fChain->SetBranchAddress("GasHitPosY", &GasHitPosY, &b_GasHitPosY);
+   fChain->SetBranchAddress("GasHitPosZ", &GasHitPosZ, &b_GasHitPosZ);
+   fChain->SetBranchAddress("GasTime", &GasTime, &b_GasTime);
    fChain->SetBranchAddress("GasDeltaEnergy", &GasDeltaEnergy, &b_GasDeltaEnergy);
-   fChain->SetBranchAddress("ParticleID", &ParticleID, &b_ParticleID);
-   fChain->SetBranchAddress("TrackID", &TrackID, &b_TrackID);
-   fChain->SetBranchAddress("ParentID", &ParentID, &b_ParentID);
-   fChain->SetBranchAddress("HitPosX", &HitPosX, &b_HitPosX);
-   fChain->SetBranchAddress("HitPosY", &HitPosY, &b_HitPosY);
-   fChain->SetBranchAddress("HitPosZ", &HitPosZ, &b_HitPosZ);
-   fChain->SetBranchAddress("Time", &Time, &b_Time);
-   fChain->SetBranchAddress("EnergyLoss", &EnergyLoss, &b_EnergyLoss);
+   fChain->SetBranchAddress("PlateParticleID", &PlateParticleID, &b_PlateParticleID);
+   fChain->SetBranchAddress("PlateTrackID", &PlateTrackID, &b_PlateTrackID);
+   fChain->SetBranchAddress("PlateParentID", &PlateParentID, &b_PlateParentID);
+   fChain->SetBranchAddress("PlatePrimaryID", &PlatePrimaryID, &b_PlatePrimaryID);
+   fChain->SetBranchAddress("PlateChannelID", &PlateChannelID, &b_PlateChannelID);
+   fChain->SetBranchAddress("PlateHitPosX", &PlateHitPosX, &b_PlateHitPosX);
+   fChain->SetBranchAddress("PlateHitPosY", &PlateHitPosY, &b_PlateHitPosY);
+   fChain->SetBranchAddress("PlateHitPosZ", &PlateHitPosZ, &b_PlateHitPosZ);
+   fChain->SetBranchAddress("PlateTime", &PlateTime, &b_PlateTime);
+   fChain->SetBranchAddress("PlateEnergyDeposition", &PlateEnergyDeposition, &b_PlateEnergyDeposition);
+   fChain->SetBranchAddress("FinalEnergy", &FinalEnergy, &b_FinalEnergy);
    fChain->SetBranchAddress("AvalancheSize", &AvalancheSize, &b_AvalancheSize);
    fChain->SetBranchAddress("AvalancheEnergy", &AvalancheEnergy, &b_AvalancheEnergy);
+   fChain->SetBranchAddress("AvalanchePrimaryID", &AvalanchePrimaryID, &b_AvalanchePrimaryID);
+   fChain->SetBranchAddress("ClusterCount", &ClusterCount, &b_ClusterCount);
+   fChain->SetBranchAddress("ClusterSize", &ClusterSize, &b_ClusterSize);
+   fChain->SetBranchAddress("ClusterPrimaryID", &ClusterPrimaryID, &b_ClusterPrimaryID);
+   fChain->SetBranchAddress("LayerCount", &LayerCount, &b_LayerCount);
    Notify();
 }
 
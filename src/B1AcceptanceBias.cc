@@ -0,0 +1,136 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AcceptanceBias.cc
+/// \brief Implementation of the B1AcceptanceBias class
+
+#include "B1AcceptanceBias.hh"
+
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1AcceptanceBias::CubeChord(const G4ThreeVector& position,
+				   const G4ThreeVector& direction, G4double halfSize,
+				   G4double& tIn, G4double& tOut)
+{
+  // Entry and exit distances of the three slabs, the ray only goes forward
+  G4double tMin = 0., tMax = DBL_MAX;
+  for(G4int i=0; i<3; i++)
+    {
+      G4double p = position[i], d = direction[i];
+      if(d == 0.)
+	{
+	  if(std::fabs(p) > halfSize)
+	    return false;
+	  continue;
+	}
+      G4double t1 = (-halfSize - p)/d, t2 = (halfSize - p)/d;
+      tMin = std::max(tMin, std::min(t1, t2));
+      tMax = std::min(tMax, std::max(t1, t2));
+      if(tMin > tMax)
+	return false;
+    }
+  tIn = tMin;
+  tOut = tMax;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1AcceptanceBias::SampleDirection(const G4ThreeVector& position,
+					   G4double halfSize, G4ThreeVector& direction)
+{
+  G4double cone = SampleCone(position, halfSize, direction);
+  if(cone > 0.)
+    return cone;
+  return SampleFaces(position, halfSize, direction);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1AcceptanceBias::SampleCone(const G4ThreeVector& position, G4double halfSize,
+				      G4ThreeVector& direction)
+{
+  G4double distance = position.mag();
+  G4double radius = std::sqrt(3.)*halfSize;
+  if(distance <= radius)
+    return 0.;
+
+  // Cosine uniform between the edge of the cone and its axis
+  G4double sinEdge = radius/distance;
+  G4double oneMinusCos = 1. - std::sqrt(1. - sinEdge*sinEdge);
+  G4double cosAngle = 1. - G4UniformRand()*oneMinusCos;
+  G4double sinAngle = std::sqrt(std::max(0., 1. - cosAngle*cosAngle));
+  G4double phi = twopi*G4UniformRand();
+
+  G4ThreeVector axis = -position/distance;
+  G4ThreeVector u1 = axis.orthogonal().unit();
+  G4ThreeVector u2 = axis.cross(u1);
+  direction = cosAngle*axis + sinAngle*(std::cos(phi)*u1 + std::sin(phi)*u2);
+  return twopi*oneMinusCos;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1AcceptanceBias::SampleFaces(const G4ThreeVector& position, G4double halfSize,
+				       G4ThreeVector& direction)
+{
+  // Faces whose outer side the position is on, all of the same area
+  G4int faces[6];
+  G4int nFaces = 0;
+  for(G4int i=0; i<3; i++)
+    {
+      if(position[i] > halfSize)
+	faces[nFaces++] = 2*i;
+      else if(position[i] < -halfSize)
+	faces[nFaces++] = 2*i + 1;
+    }
+  if(nFaces == 0)
+    return 0.;
+
+  G4int face = faces[std::min(G4int(G4UniformRand()*nFaces), nFaces - 1)];
+  G4int axis = face/2;
+  G4double side = (face%2 == 0) ? halfSize : -halfSize;
+  G4double point[3];
+  for(G4int i=0; i<3; i++)
+    point[i] = (i == axis) ? side : halfSize*(2*G4UniformRand() - 1.);
+
+  G4ThreeVector toPoint = G4ThreeVector(point[0], point[1], point[2]) - position;
+  G4double distance2 = toPoint.mag2();
+  G4double distance = std::sqrt(distance2);
+  direction = toPoint/distance;
+  G4double cosFace = std::fabs(toPoint[axis])/distance;
+  G4double area = nFaces*4*halfSize*halfSize;
+  return area*cosFace/distance2;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
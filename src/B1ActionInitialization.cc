@@ -31,7 +31,8 @@
 #include "B1PrimaryGeneratorAction.hh"
 #include "B1RunAction.hh"
 #include "B1EventAction.hh"
-#include "B1SteppingAction.hh"
+#include "B1TrackingAction.hh"
+#include "B1StackingAction.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -56,15 +57,17 @@ void B1ActionInitialization::BuildForMaster() const
 
 void B1ActionInitialization::Build() const
 {
-  SetUserAction(new B1PrimaryGeneratorAction);
-
   B1RunAction* runAction = new B1RunAction;
   SetUserAction(runAction);
+
+  SetUserAction(new B1PrimaryGeneratorAction(runAction));
   
   B1EventAction* eventAction = new B1EventAction(runAction);
   SetUserAction(eventAction);
   
-  SetUserAction(new B1SteppingAction(eventAction));
+  SetUserAction(new B1TrackingAction(runAction, eventAction));
+
+  SetUserAction(new B1StackingAction(runAction));
 }  
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,315 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1CosmicMuonGenerator.cc
+/// \brief Implementation of the B1CosmicMuonGenerator class
+
+#include "B1CosmicMuonGenerator.hh"
+#include "B1AcceptanceBias.hh"
+
+#include "G4ParticleGun.hh"
+#include "G4ParticleTable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  // Cells of the tables in cos(theta) and log(p)
+  const G4int kCosBins = 100;
+  const G4int kMomentumBins = 200;
+
+  // Height of the plane above the top face of the cube
+  const G4double kPlaneGap = 1*cm;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1CosmicMuonGenerator::B1CosmicMuonGenerator()
+  : fSphere(false),
+    fMinMomentum(1*GeV),
+    fMaxMomentum(2*TeV),
+    fMaxZenith(80*deg),
+    fChargeRatio(1.27),
+    fPlaneHalfWidth(0.),
+    fTablesValid(false),
+    fHalfSize(0.),
+    fWorldHalfSize(0.),
+    fSurfaceSize(0.),
+    fRate(0.),
+    fCosMin(0.),
+    fCosWidth(0.)
+{
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+  fMuPlus = particleTable->FindParticle("mu+");
+  fMuMinus = particleTable->FindParticle("mu-");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1CosmicMuonGenerator::~B1CosmicMuonGenerator()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1CosmicMuonGenerator::VerticalIntensity(G4double momentum)
+{
+  // Reyna, hep-ph/0604145, p in GeV/c and cm-2 s-1 sr-1 (GeV/c)-1
+  const G4double c1 = 0.00253, c2 = 0.2455, c3 = 1.288, c4 = -0.2555, c5 = 0.0209;
+  G4double p = momentum/GeV;
+  if(p <= 0.)
+    return 0.;
+  G4double y = std::log10(p);
+  G4double exponent = c2 + c3*y + c4*y*y + c5*y*y*y;
+  return c1*std::pow(p, -exponent)/(cm2*s*GeV);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1CosmicMuonGenerator::BuildTables(G4double halfSize, G4double worldHalfSize)
+{
+  fHalfSize = halfSize;
+  fWorldHalfSize = worldHalfSize;
+
+  G4double cosMin = std::max(std::cos(fMaxZenith), 0.);
+  G4double cosWidth = (1. - cosMin)/kCosBins;
+  G4double logRatio = std::log(fMaxMomentum/fMinMomentum)/kMomentumBins;
+
+  // Flux of each cell, per unit area of the plane or of the disk
+  fCells.resize(kCosBins*kMomentumBins);
+  std::vector<G4double> flux(fCells.size());
+  G4double totalFlux = 0.;
+  for(G4int i=0; i<kCosBins; i++)
+    {
+      G4double cosTheta = cosMin + (i + 0.5)*cosWidth;
+      G4double solidAngle = twopi*cosWidth*(fSphere ? 1. : cosTheta);
+      for(G4int j=0; j<kMomentumBins; j++)
+	{
+	  Cell& cell = fCells[i*kMomentumBins + j];
+	  cell.cosMin = cosMin + i*cosWidth;
+	  cell.cosWidth = cosWidth;
+	  cell.pMin = fMinMomentum*std::exp(j*logRatio);
+	  cell.pMax = fMinMomentum*std::exp((j + 1)*logRatio);
+
+	  // I(p, theta) = cos^3 I_V(p cos), a power law within the cell
+	  G4double cos3 = cosTheta*cosTheta*cosTheta;
+	  G4double i0 = cos3*VerticalIntensity(cell.pMin*cosTheta);
+	  G4double i1 = cos3*VerticalIntensity(cell.pMax*cosTheta);
+	  G4double integral = 0.;
+	  cell.index = 0.;
+	  if(i0 > 0. && i1 > 0.)
+	    {
+	      cell.index = std::log(i0/i1)/logRatio;
+	      G4double n1 = 1. - cell.index;
+	      integral = (std::fabs(n1) < 1e-6)
+		? i0*cell.pMin*logRatio
+		: i0*cell.pMin*std::expm1(n1*logRatio)/n1;
+	    }
+	  flux[i*kMomentumBins + j] = solidAngle*integral;
+	  totalFlux += flux[i*kMomentumBins + j];
+	}
+    }
+
+  // Alias tables of the cells, and of the momentum cells of each zenith bin
+  G4int nCells = fCells.size();
+  fProbability.resize(nCells);
+  fAlias.resize(nCells);
+  BuildAlias(flux.data(), nCells, fProbability.data(), fAlias.data());
+
+  fCosMin = cosMin;
+  fCosWidth = cosWidth;
+  fCosDensity.assign(kCosBins, 0.);
+  fMomentumProbability.resize(nCells);
+  fMomentumAlias.resize(nCells);
+  for(G4int i=0; i<kCosBins; i++)
+    {
+      G4int first = i*kMomentumBins;
+      for(G4int j=0; j<kMomentumBins; j++)
+	fCosDensity[i] += flux[first + j];
+      fCosDensity[i] /= totalFlux*cosWidth;
+      BuildAlias(&flux[first], kMomentumBins,
+		 &fMomentumProbability[first], &fMomentumAlias[first]);
+    }
+
+  // Surface enclosing the cube: a plane wide enough for the inclined
+  // muons reaching the bottom of the cube, or a sphere through its
+  // corners, both within the world
+  G4double area;
+  if(fSphere)
+    {
+      fSurfaceSize = std::min(std::sqrt(3.)*halfSize, worldHalfSize);
+      area = pi*fSurfaceSize*fSurfaceSize;
+    }
+  else
+    {
+      fSurfaceSize = (fPlaneHalfWidth > 0.) ? fPlaneHalfWidth
+	: halfSize*(1. + 2*std::tan(std::min(fMaxZenith, 89*deg)));
+      fSurfaceSize = std::min(fSurfaceSize, worldHalfSize);
+      area = 4*fSurfaceSize*fSurfaceSize;
+    }
+  fRate = totalFlux*area;
+  fTablesValid = true;
+
+  G4cout << " B1CosmicMuonGenerator: " << G4BestUnit(fMinMomentum, "Energy")
+	 << "/c to " << G4BestUnit(fMaxMomentum, "Energy") << "/c, zenith below "
+	 << fMaxZenith/deg << " deg, "
+	 << (fSphere ? "sphere of radius " : "plane of half width ")
+	 << G4BestUnit(fSurfaceSize, "Length") << ", "
+	 << fRate*s << " muons/s" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1CosmicMuonGenerator::BuildAlias(const G4double* weights, G4int n,
+				       G4double* probability, G4int* alias)
+{
+  // Alias table (Vose), entry k is kept with probability[k] and replaced
+  // by alias[k] otherwise
+  G4double total = 0.;
+  for(G4int k=0; k<n; k++)
+    total += weights[k];
+  std::vector<G4double> scaled(n);
+  std::vector<G4int> small, large;
+  for(G4int k=0; k<n; k++)
+    {
+      probability[k] = 1.;
+      alias[k] = k;
+      scaled[k] = (total > 0.) ? weights[k]*n/total : 1.;
+      (scaled[k] < 1. ? small : large).push_back(k);
+    }
+  while(!small.empty() && !large.empty())
+    {
+      G4int less = small.back(), more = large.back();
+      small.pop_back();
+      probability[less] = scaled[less];
+      alias[less] = more;
+      scaled[more] -= 1. - scaled[less];
+      if(scaled[more] < 1.)
+	{
+	  large.pop_back();
+	  small.push_back(more);
+	}
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1CosmicMuonGenerator::SampleMomentum(const Cell& cell, G4double u) const
+{
+  // Inverse of the cumulative distribution of p^-index in the cell
+  G4double n1 = 1. - cell.index;
+  G4double ratio = cell.pMax/cell.pMin;
+  if(std::fabs(n1) < 1e-6)
+    return cell.pMin*std::pow(ratio, u);
+  return cell.pMin*std::pow(1. + u*(std::pow(ratio, n1) - 1.), 1./n1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1CosmicMuonGenerator::Generate(G4double halfSize, G4double worldHalfSize,
+					 G4ParticleGun* gun, G4double& weight,
+					 G4bool coneBias)
+{
+  if(!fTablesValid || halfSize != fHalfSize || worldHalfSize != fWorldHalfSize)
+    BuildTables(halfSize, worldHalfSize);
+
+  G4ThreeVector position, direction;
+  G4double momentum = fMinMomentum;
+  weight = 1.;
+  if(!fSphere)
+    position = G4ThreeVector(fSurfaceSize*(2*G4UniformRand() - 1.),
+			     halfSize + kPlaneGap,
+			     fSurfaceSize*(2*G4UniformRand() - 1.));
+
+  // Aimed at the cube from the plane, natural direction from the sphere
+  // around the cube
+  G4double cone = (coneBias && !fSphere)
+    ? B1AcceptanceBias::SampleDirection(position, halfSize, direction) : 0.;
+  if(cone > 0.)
+    {
+      G4double cosTheta = -direction.y();
+      G4int i = G4int(std::floor((cosTheta - fCosMin)/fCosWidth));
+      if(cosTheta < fCosMin || i < 0)
+	weight = 0.;
+      else
+	{
+	  i = std::min(i, kCosBins - 1);
+	  weight = fCosDensity[i]/twopi*cone;
+
+	  // Momentum cell of this zenith bin from its alias table
+	  G4int first = i*kMomentumBins;
+	  G4double u = G4UniformRand()*kMomentumBins;
+	  G4int j = std::min(G4int(u), kMomentumBins - 1);
+	  if(u - j >= fMomentumProbability[first + j])
+	    j = fMomentumAlias[first + j];
+	  momentum = SampleMomentum(fCells[first + j], G4UniformRand());
+	}
+    }
+  else
+    {
+      // Cell from the alias table, then position in the cell
+      G4double u = G4UniformRand()*fCells.size();
+      G4int k = std::min(G4int(u), G4int(fCells.size()) - 1);
+      if(u - k >= fProbability[k])
+	k = fAlias[k];
+      const Cell& cell = fCells[k];
+      G4double cosTheta = cell.cosMin + G4UniformRand()*cell.cosWidth;
+      G4double sinTheta = std::sqrt(std::max(0., 1. - cosTheta*cosTheta));
+      G4double phi = twopi*G4UniformRand();
+      momentum = SampleMomentum(cell, G4UniformRand());
+
+      // Downward going, +y is up
+      direction = G4ThreeVector(sinTheta*std::cos(phi), -cosTheta, sinTheta*std::sin(phi));
+
+      if(fSphere)
+	{
+	  // Uniform on the disk perpendicular to the muon through the centre,
+	  // moved back along the muon to its entry into the sphere
+	  G4ThreeVector u1 = direction.orthogonal().unit();
+	  G4ThreeVector u2 = direction.cross(u1);
+	  G4double r2 = fSurfaceSize*fSurfaceSize*G4UniformRand();
+	  G4double r = std::sqrt(r2);
+	  G4double psi = twopi*G4UniformRand();
+	  position = r*std::cos(psi)*u1 + r*std::sin(psi)*u2
+	    - std::sqrt(fSurfaceSize*fSurfaceSize - r2)*direction;
+	}
+    }
+
+  G4bool muPlus = G4UniformRand()*(1. + fChargeRatio) < fChargeRatio;
+  gun->SetParticleDefinition(muPlus ? fMuPlus : fMuMinus);
+  gun->SetParticleMomentum(momentum);
+  gun->SetParticleMomentumDirection(direction);
+  gun->SetParticlePosition(position);
+
+  return 1./fRate;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -28,8 +28,17 @@
 /// \brief Implementation of the B1DetectorConstruction class
 
 #include "B1DetectorConstruction.hh"
+#include "B1DetectorMessenger.hh"
 
 #include "B1ElectricFieldSetup.hh"
+#include "B1RPCSensitiveDetector.hh"
+#include "B1GasFastSimModel.hh"
+#include "B1ChannelID.hh"
+#include "B1NavigationBenchmark.hh"
+#include "B1FieldBenchmark.hh"
+#include "B1OverlapCache.hh"
+#include "B1StepLimits.hh"
+#include "B1RPCLayout.hh"
 
 #include "G4RunManager.hh"
 #include "G4NistManager.hh"
@@ -44,8 +53,29 @@
 #include "G4VisAttributes.hh"
 #include "G4PVReplica.hh"
 #include "G4UnitsTable.hh"
-#include "G4UserLimits.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4ParticleTable.hh"
+#include "G4SDManager.hh"
+#include "G4AutoDelete.hh"
+#include "G4UImanager.hh"
+#include "G4StateManager.hh"
+#include "G4GeometryManager.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4SolidStore.hh"
+#include "G4TransportationManager.hh"
+#include "G4Navigator.hh"
+#include "G4Timer.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
 
+#ifdef G4LIB_USE_GDML
+#include "G4GDMLParser.hh"
+#endif
+
+#include <cmath>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -53,33 +83,87 @@
 
 B1DetectorConstruction::B1DetectorConstruction()
   : G4VUserDetectorConstruction()
-{ }
+{
+  SetModel("codexb");
+
+  // Regions and their step limits are kept when the geometry is rebuilt.
+  // By default only charged particles in the gas are limited to 0.01 mm
+  // steps, the region cuts are the default cuts until set.
+  fGasRegion = new G4Region("RPCGas");
+  fPlateRegion = new G4Region("RPCPlate");
+  fEnvelopeRegion = new G4Region("Envelope");
+  fGasLimits = new B1StepLimits("RPCGas");
+  fGasLimits->SetMaxAllowedStep(0.01*mm);
+  fPlateLimits = new B1StepLimits("RPCPlate");
+  fEnvelopeLimits = new B1StepLimits("Envelope");
+  fWorldLimits = new B1StepLimits("World");
+
+  fMessenger = new B1DetectorMessenger(this);
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1DetectorConstruction::~B1DetectorConstruction()
-{ }
+{
+  delete fMessenger;
+  delete fGasLimits;
+  delete fPlateLimits;
+  delete fEnvelopeLimits;
+  delete fWorldLimits;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 G4VPhysicalVolume* B1DetectorConstruction::Construct()
 {  
+  G4Timer timer;
+  timer.Start();
+
+  // Clean the old geometry when it is rebuilt between runs
+  G4GeometryManager::GetInstance()->OpenGeometry();
+  ReleaseRegions();
+  G4PhysicalVolumeStore::GetInstance()->Clean();
+  G4LogicalVolumeStore::GetInstance()->Clean();
+  G4SolidStore::GetInstance()->Clean();
+  fLogicGas = nullptr;
+  fLogicPlate = nullptr;
+
+  // Build the geometry, or read it from a GDML file
+  G4VPhysicalVolume* physWorld;
+  if(fGdmlReadFile.empty())
+    physWorld = ConstructVolumes();
+  else
+    physWorld = ReadGdml();
+
+  timer.Stop();
+  G4cout << "Geometry " << (fGdmlReadFile.empty() ? "constructed" : "read from " + fGdmlReadFile)
+	 << " in " << timer.GetRealElapsed() << " s" << G4endl;
+
+  if(physWorld)
+    ConfigureRegions(physWorld);
+
+  if(fCheckOverlaps)
+    CheckOverlaps();
+
+  return physWorld;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VPhysicalVolume* B1DetectorConstruction::ConstructVolumes()
+{
   // Get nist material manager
   G4NistManager* nist = G4NistManager::Instance();
 
-  // Convert between atomic mass units and kg, set Boltzmann constant in SI units
-  static const G4double amu = 1.66054e-27*kg;
-  G4double kBoltzmann = 1.38064582e-23*joule/kelvin;
-   
-  // Option to switch on/off checking of volumes overlaps
+  // Overlaps are not checked as the volumes are placed but once the whole
+  // geometry is built, and only if this geometry has not been checked
+  // before (see CheckOverlaps())
   //
-  G4bool checkOverlaps = true;
+  G4bool checkOverlaps = false;
 
   // Visualisation settings
   G4VisAttributes *envelopeVisAttributes = new G4VisAttributes(); // Needed to make envelopes invisible
   envelopeVisAttributes->SetVisibility(false);
-  G4VisAttributes *gasVisAttributes = new G4VisAttributes(); // Make gas volume green
-  gasVisAttributes->SetColour(0., 1., 0.);
 
   //     
   // World
@@ -110,65 +194,18 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   // Full model of RPCs
   if(!fSiliconModel)
     {
-      // Gas parameters
-      G4double gasThick = 1*mm;
-      G4double gasPressure = 100000*hep_pascal;
+      // Gas
+      G4Material *gasMat = GasMaterial();
       
-      // Gas components
-      G4Material *tetra = new G4Material("Tetrafluroethane", 4.25*kg/m3, 3, kStateGas);
-      tetra->AddElement(nist->FindOrBuildElement(6), 2);
-      tetra->AddElement(nist->FindOrBuildElement(1), 2);
-      tetra->AddElement(nist->FindOrBuildElement(9), 4);
-      G4double tetraMass = (2*12.0107 + 2*1.00784 + 4*18.998403)*amu; // Mass of tetrafluoroethane in kg
-      G4double tetraPercent = 94.7; // Percentage of mixture
-	
-      G4Material *butane = nist->FindOrBuildMaterial("G4_BUTANE"); // assuming butane and iso-butane have same properties - density matches
-      G4double butaneMass = (4*12.0107 + 10*1.00784)*amu; // Mass of butane in kg
-      G4double butanePercent = 5.0; // Percentage of mixture
-      
-      G4Material *sf6 = new G4Material("Sulphur Hexafluoride", 6.17*kg/m3, 2, kStateGas);
-      sf6->AddElement(nist->FindOrBuildElement(16), 1);
-      sf6->AddElement(nist->FindOrBuildElement(9), 6);
-      G4double sf6Mass = (32.065 + 6*18.998403)*amu; // Mass of SF6 in kg
-      G4double sf6Percent = 0.3; // Percentage of mixture
-
-      G4double averageMass = (tetraMass*tetraPercent + butaneMass*butanePercent + sf6Mass*sf6Percent)/100;
-      G4double gasDensity = (gasPressure*averageMass)/(kBoltzmann*CLHEP::STP_Temperature);
-      G4Material *gasMat = new G4Material("rpcGas", gasDensity, 3, kStateGas, CLHEP::STP_Temperature, gasPressure);
-      gasMat->AddMaterial(tetra, tetraPercent*perCent);
-      gasMat->AddMaterial(butane, butanePercent*perCent);
-      gasMat->AddMaterial(sf6, sf6Percent*perCent);
-      std::cout << gasDensity/(kg/m3) << std::endl;
-      
-      // Plate Parameters
-      G4double plateThick = 1.2*mm;
-      G4double plateSizeX = 2*m;
-      G4double plateSizeY = 1*m;
+      // Plate material
       G4Material *plateMat = nist->FindOrBuildMaterial("G4_BAKELITE");
 
-      // Electric field
-      B1ElectricFieldSetup *emFieldSetup = new B1ElectricFieldSetup();
-
-      // Overall detector parameters
-      if(fCodexb) // Full size detector
-	{
-	  detSizeXY = 10*m;
-	  layerSep = 4*cm; // from surface of one layer to surface of the next
-	  nFaceLayers = 6;
-	  nPerCentreGroup = 3;
-	  nCentreLayers = 5;
-	}
-      else // Demonstrator module
-      	{
-      	  detSizeXY = 2*m;
-      	  layerSep = 4*cm;
-      	  nFaceLayers = 3;
-      	  nPerCentreGroup = 3;
-      	  nCentreLayers = 1;
-      	}
-      G4double rpcThick = 2*plateThick + gasThick;
-      G4double faceThick = nFaceLayers*rpcThick + (nFaceLayers - 1)*layerSep;
-      G4double groupThick = nPerCentreGroup*rpcThick + (nPerCentreGroup - 1)*layerSep;
+      // Overall detector parameters, set by the model and /rpc/geometry/ commands
+      B1RPCLayout layout = GetLayout();
+      G4double rpcThick = layout.RPCThickness();
+      G4double faceThick = layout.FaceThickness();
+      G4double groupThick = layout.GroupThickness();
+      G4double faceOffset = layout.FaceOffset();
 
       // Centre Envelope
       G4Box *solidCentreEnv =
@@ -193,12 +230,12 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
       
       // Face envelopes
       std::vector<G4ThreeVector> facePos; // Positions of faces
-      facePos.push_back(G4ThreeVector(0, 0, -0.5*detSizeXY - 0.5*faceThick));
-      facePos.push_back(G4ThreeVector(0, 0, 0.5*detSizeXY + 0.5*faceThick));
-      facePos.push_back(G4ThreeVector(-0.5*detSizeXY - 0.5*faceThick, 0, 0));
-      facePos.push_back(G4ThreeVector(0.5*detSizeXY + 0.5*faceThick, 0, 0));
-      facePos.push_back(G4ThreeVector(0, -0.5*detSizeXY - 0.5*faceThick, 0));
-      facePos.push_back(G4ThreeVector(0, 0.5*detSizeXY + 0.5*faceThick, 0));
+      facePos.push_back(G4ThreeVector(0, 0, -faceOffset));
+      facePos.push_back(G4ThreeVector(0, 0, faceOffset));
+      facePos.push_back(G4ThreeVector(-faceOffset, 0, 0));
+      facePos.push_back(G4ThreeVector(faceOffset, 0, 0));
+      facePos.push_back(G4ThreeVector(0, -faceOffset, 0));
+      facePos.push_back(G4ThreeVector(0, faceOffset, 0));
       
       G4Box *solidFaceEnv =
 	new G4Box("Face",                                                // its name
@@ -242,8 +279,7 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
       
       for(unsigned int nGroup=0; nGroup<nCentreLayers; nGroup++) // Places the centre RPC groups
 	{
-	  G4double groupSep = (detSizeXY - nCentreLayers*groupThick)/(nCentreLayers + 1); // Equal spacing along the length of the detector
-	  G4double groupZPos = -0.5*detSizeXY + groupSep + 0.5*groupThick + nGroup*(groupThick + groupSep);
+	  G4double groupZPos = layout.GroupZ(nGroup); // Equal spacing along the length of the detector
 
 	  G4VPhysicalVolume *physGroupEnv = 
 	    new G4PVPlacement(0,                             // no rotation
@@ -256,104 +292,33 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
 			      checkOverlaps);                // overlaps checking
 	}
 
-      // Sub envelopes for RPC layers
-      G4Box *solidRPCEnv =
-	new G4Box("RPC",                                              // its name
-		  0.5*detSizeXY, 0.5*detSizeXY, 0.5*rpcThick);        // its size
-
-      G4LogicalVolume *logicRPCEnv =
-	new G4LogicalVolume(solidRPCEnv,          // its solid
-			    worldMat,             // its material
-			    "RPC");               // its name
-      logicRPCEnv->SetVisAttributes(envelopeVisAttributes);
-      
-      // Placing RPCs in face layers
-      for(unsigned int nLayers=0; nLayers<nFaceLayers; nLayers++)
+      // Number of pads along x (strips) and y, the pads must tile the layers
+      G4int nReplicasX = std::lround(detSizeXY/plateSizeX);
+      G4int nReplicasY = std::lround(detSizeXY/plateSizeY);
+      if(std::fabs(nReplicasX*plateSizeX - detSizeXY) > 1*um
+	 || std::fabs(nReplicasY*plateSizeY - detSizeXY) > 1*um)
 	{
-	  G4double rpcZPos = -0.5*faceThick + 0.5*rpcThick + nLayers*(rpcThick + layerSep);
-	  G4VPhysicalVolume *physRPCEnv = 
-	    new G4PVPlacement(0,                           // no rotation
-			      G4ThreeVector(0, 0, rpcZPos),// at each layer position in the face
-			      logicRPCEnv,                 // its logical volume
-			      "RPC",                       // its name
-			      logicFaceEnv,                // its mother  volume
-			      false,                       // no boolean operation
-			      nLayers,                     // copy number
-			      checkOverlaps);              // overlaps checking
+	  G4ExceptionDescription msg;
+	  msg << "Pads of " << G4BestUnit(plateSizeX, "Length") << " x "
+	      << G4BestUnit(plateSizeY, "Length") << " do not tile the detector size "
+	      << G4BestUnit(detSizeXY, "Length");
+	  G4Exception("B1DetectorConstruction::Construct()", "B1Geometry001",
+		      FatalErrorInArgument, msg);
 	}
-      // Placing RPCs inside groups in central volume
-      for(unsigned int nLayers=0; nLayers<nPerCentreGroup; nLayers++)
-	{
-	  G4double rpcZPos = -0.5*groupThick + 0.5*rpcThick + nLayers*(rpcThick + layerSep);
-	  G4VPhysicalVolume *physRPCCentreEnv = 
-	    new G4PVPlacement(0,                           // no rotation
-			      G4ThreeVector(0, 0, rpcZPos),// at each layer position in the group
-			      logicRPCEnv,                 // its logical volume
-			      "RPC",                       // its name
-			      logicCentreGroup,            // its mother  volume
-			      false,                       // no boolean operation
-			      nLayers,                     // copy number
-			      checkOverlaps);              // overlaps checking
-	}
-      
-      // Sub envelopes for plates and gas inside RPC
-      G4Box *solidPlateEnv =
-	new G4Box("Plate",                                              // its name
-		  0.5*detSizeXY, 0.5*detSizeXY, 0.5*plateThick);        // its size
 
-      G4LogicalVolume *logicPlateEnv =                         
-	new G4LogicalVolume(solidPlateEnv,      // its solid
-			    worldMat,           // its material
-			    "Plate");           // its name
-      logicPlateEnv->SetVisAttributes(envelopeVisAttributes);
-
-      // Loop places plates at both ends of the RPC
-      for(unsigned int nPlate=0; nPlate<2; nPlate++)
+      // The strip and pad of a channel ID have 8 bits each
+      if(nReplicasX > G4int(B1ChannelID::kMaxStrips)
+	 || nReplicasY > G4int(B1ChannelID::kMaxPads))
 	{
-	  G4ThreeVector platePos = G4ThreeVector(0, 0, -0.5*rpcThick + 0.5*plateThick);
-	  if(nPlate%2==0)
-	    platePos*=-1; // flip sign to place at front/back of RPC
-	  G4VPhysicalVolume *physPlateEnv = 
-	    new G4PVPlacement(0,               // no rotation
-			      platePos,        // at the front/back of the RPC layer
-			      logicPlateEnv,   // its logical volume
-			      "Plate",         // its name
-			      logicRPCEnv,     // its mother  volume
-			      false,           // no boolean operation
-			      nPlate,          // copy number
-			      checkOverlaps);  // overlaps checking
+	  G4ExceptionDescription msg;
+	  msg << nReplicasX << " x " << nReplicasY << " pads per layer, more than the "
+	      << B1ChannelID::kMaxStrips << " x " << B1ChannelID::kMaxPads
+	      << " of the channel IDs";
+	  G4Exception("B1DetectorConstruction::Construct()", "B1Geometry004",
+		      FatalErrorInArgument, msg);
 	}
-      G4Box *solidGasEnv =
-	new G4Box("Gas",                                                // its name
-		  0.5*detSizeXY, 0.5*detSizeXY, 0.5*gasThick);          // its size
-
-      G4LogicalVolume *logicGasEnv =                         
-	new G4LogicalVolume(solidGasEnv,        // its solid
-			    worldMat,           // its material
-			    "Gas");             // its name
-      logicGasEnv->SetVisAttributes(envelopeVisAttributes);
-
-      G4VPhysicalVolume *physGasEnv = 
-	new G4PVPlacement(0,                     // no rotation
-			  G4ThreeVector(0, 0, 0),// middle of the RPC layer
-			  logicGasEnv,           // its logical volume
-			  "Gas",                 // its name
-			  logicRPCEnv,           // its mother  volume
-			  false,                 // no boolean operation
-			  0,                     // copy number
-			  checkOverlaps);        // overlaps checking
-      
-      // Plate replicas solid and logical volumes
-      G4Box *solidPlateStrip =
-	new G4Box("Plate",                                              // its name
-		  0.5*plateSizeX, 0.5*detSizeXY, 0.5*plateThick);       // its size
-
-      G4LogicalVolume *logicPlateStrip =                         
-	new G4LogicalVolume(solidPlateStrip,    // its solid
-			    plateMat,           // its material
-			    "Plate");           // its name
-      logicPlateStrip->SetVisAttributes(envelopeVisAttributes);
 
+      // Pad solids and logical volumes, the readout cells of the plates and gas
       G4Box *solidPlate =
 	new G4Box("Plate",                                              // its name
 		  0.5*plateSizeX, 0.5*plateSizeY, 0.5*plateThick);      // its size
@@ -363,37 +328,6 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
 			    plateMat,           // its material
 			    "Plate");           // its name
 
-      // Plate placement
-      G4int nReplicasX = detSizeXY/plateSizeX;
-      G4int nReplicasY = detSizeXY/plateSizeY;
-
-      G4VPhysicalVolume *plateReplicaStrip =
-      	new G4PVReplica("Plate",                  // name
-			logicPlateStrip,          // logical volume
-			logicPlateEnv,            // mother volume
-			kXAxis,                   // replication axis
-			nReplicasX,               // number of replicas
-			plateSizeX);              // width
-
-      G4VPhysicalVolume *plateReplica =
-      	new G4PVReplica("Plate",                  // name
-			logicPlate,               // logical volume
-			plateReplicaStrip,        // mother volume
-			kYAxis,                   // replication axis
-			nReplicasY,               // number of replicas
-			plateSizeY);              // width
-
-      // Gas replicas solid and logical volumes
-      G4Box *solidGasStrip =
-	new G4Box("Gas",                                              // its name
-		  0.5*plateSizeX, 0.5*detSizeXY, 0.5*gasThick);       // its size
-
-      G4LogicalVolume *logicGasStrip =                         
-	new G4LogicalVolume(solidGasStrip,    // its solid
-			    gasMat,           // its material
-			    "Gas");           // its name
-      logicGasStrip->SetVisAttributes(envelopeVisAttributes);
-
       G4Box *solidGas =
 	new G4Box("Gas",                                              // its name
 		  0.5*plateSizeX, 0.5*plateSizeY, 0.5*gasThick);      // its size
@@ -402,33 +336,165 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
 	new G4LogicalVolume(solidGas,         // its solid
 			    gasMat,           // its material
 			    "Gas");           // its name
-      logicGas->SetVisAttributes(gasVisAttributes);
-      logicGas->SetFieldManager(emFieldSetup->GetLocalFieldManager(), false);
-      //std::cout << "EM FIELD IS SWITCHED OFF VERY IMPORTANT TO KNOW THIS TURN IT BACK ON SOMETIME" << std::endl;
-
-      // Gas placement
-      G4VPhysicalVolume *gasReplicaStrip =
-      	new G4PVReplica("Gas",                  // name
-			logicGasStrip,          // logical volume
-			logicGasEnv,            // mother volume
-			kXAxis,                 // replication axis
-			nReplicasX,             // number of replicas
-			plateSizeX);            // width
-
-      G4VPhysicalVolume *gasReplica =
-      	new G4PVReplica("Gas",                  // name
-			logicGas,               // logical volume
-			gasReplicaStrip,        // mother volume
-			kYAxis,                 // replication axis
-			nReplicasY,             // number of replicas
-			plateSizeY);            // width
-
-      // Step limits - RPCs
-      G4double rpcLimit = 0.01*mm;
-      G4UserLimits *rpcLimiter = new G4UserLimits();
-      rpcLimiter->SetMaxAllowedStep(rpcLimit);
-      logicGas->SetUserLimits(rpcLimiter);
-      logicPlate->SetUserLimits(rpcLimiter);
+
+      if(!fFlatLayout)
+	{
+	  // Sub envelopes for RPC layers
+	  G4Box *solidRPCEnv =
+	    new G4Box("RPC",                                              // its name
+		      0.5*detSizeXY, 0.5*detSizeXY, 0.5*rpcThick);        // its size
+
+	  G4LogicalVolume *logicRPCEnv =
+	    new G4LogicalVolume(solidRPCEnv,          // its solid
+				worldMat,             // its material
+				"RPC");               // its name
+	  logicRPCEnv->SetVisAttributes(envelopeVisAttributes);
+      
+	  // Placing RPCs in face layers
+	  for(unsigned int nLayers=0; nLayers<nFaceLayers; nLayers++)
+	    {
+	      G4double rpcZPos = layout.LayerZ(faceThick, nLayers);
+	      G4VPhysicalVolume *physRPCEnv = 
+		new G4PVPlacement(0,                           // no rotation
+				  G4ThreeVector(0, 0, rpcZPos),// at each layer position in the face
+				  logicRPCEnv,                 // its logical volume
+				  "RPC",                       // its name
+				  logicFaceEnv,                // its mother  volume
+				  false,                       // no boolean operation
+				  nLayers,                     // copy number
+				  checkOverlaps);              // overlaps checking
+	    }
+	  // Placing RPCs inside groups in central volume
+	  for(unsigned int nLayers=0; nLayers<nPerCentreGroup; nLayers++)
+	    {
+	      G4double rpcZPos = layout.LayerZ(groupThick, nLayers);
+	      G4VPhysicalVolume *physRPCCentreEnv = 
+		new G4PVPlacement(0,                           // no rotation
+				  G4ThreeVector(0, 0, rpcZPos),// at each layer position in the group
+				  logicRPCEnv,                 // its logical volume
+				  "RPC",                       // its name
+				  logicCentreGroup,            // its mother  volume
+				  false,                       // no boolean operation
+				  nLayers,                     // copy number
+				  checkOverlaps);              // overlaps checking
+	    }
+      
+	  // Sub envelopes for plates and gas inside RPC
+	  G4Box *solidPlateEnv =
+	    new G4Box("Plate",                                              // its name
+		      0.5*detSizeXY, 0.5*detSizeXY, 0.5*plateThick);        // its size
+
+	  G4LogicalVolume *logicPlateEnv =                         
+	    new G4LogicalVolume(solidPlateEnv,      // its solid
+				worldMat,           // its material
+				"Plate");           // its name
+	  logicPlateEnv->SetVisAttributes(envelopeVisAttributes);
+
+	  // Loop places plates at both ends of the RPC
+	  for(unsigned int nPlate=0; nPlate<2; nPlate++)
+	    {
+	      G4ThreeVector platePos = G4ThreeVector(0, 0, -0.5*rpcThick + 0.5*plateThick);
+	      if(nPlate%2==0)
+		platePos*=-1; // flip sign to place at front/back of RPC
+	      G4VPhysicalVolume *physPlateEnv = 
+		new G4PVPlacement(0,               // no rotation
+				  platePos,        // at the front/back of the RPC layer
+				  logicPlateEnv,   // its logical volume
+				  "Plate",         // its name
+				  logicRPCEnv,     // its mother  volume
+				  false,           // no boolean operation
+				  nPlate,          // copy number
+				  checkOverlaps);  // overlaps checking
+	    }
+	  G4Box *solidGasEnv =
+	    new G4Box("Gas",                                                // its name
+		      0.5*detSizeXY, 0.5*detSizeXY, 0.5*gasThick);          // its size
+
+	  G4LogicalVolume *logicGasEnv =                         
+	    new G4LogicalVolume(solidGasEnv,        // its solid
+				worldMat,           // its material
+				"Gas");             // its name
+	  logicGasEnv->SetVisAttributes(envelopeVisAttributes);
+
+	  G4VPhysicalVolume *physGasEnv = 
+	    new G4PVPlacement(0,                     // no rotation
+			      G4ThreeVector(0, 0, 0),// middle of the RPC layer
+			      logicGasEnv,           // its logical volume
+			      "Gas",                 // its name
+			      logicRPCEnv,           // its mother  volume
+			      false,                 // no boolean operation
+			      0,                     // copy number
+			      checkOverlaps);        // overlaps checking
+      
+	  // Plate strip replica solid and logical volume
+	  G4Box *solidPlateStrip =
+	    new G4Box("Plate",                                              // its name
+		      0.5*plateSizeX, 0.5*detSizeXY, 0.5*plateThick);       // its size
+
+	  G4LogicalVolume *logicPlateStrip =                         
+	    new G4LogicalVolume(solidPlateStrip,    // its solid
+				plateMat,           // its material
+				"Plate");           // its name
+	  logicPlateStrip->SetVisAttributes(envelopeVisAttributes);
+
+	  // Plate placement
+	  G4VPhysicalVolume *plateReplicaStrip =
+	    new G4PVReplica("Plate",                  // name
+			    logicPlateStrip,          // logical volume
+			    logicPlateEnv,            // mother volume
+			    kXAxis,                   // replication axis
+			    nReplicasX,               // number of replicas
+			    plateSizeX);              // width
+
+	  G4VPhysicalVolume *plateReplica =
+	    new G4PVReplica("Plate",                  // name
+			    logicPlate,               // logical volume
+			    plateReplicaStrip,        // mother volume
+			    kYAxis,                   // replication axis
+			    nReplicasY,               // number of replicas
+			    plateSizeY);              // width
+
+	  // Gas strip replica solid and logical volume
+	  G4Box *solidGasStrip =
+	    new G4Box("Gas",                                              // its name
+		      0.5*plateSizeX, 0.5*detSizeXY, 0.5*gasThick);       // its size
+
+	  G4LogicalVolume *logicGasStrip =                         
+	    new G4LogicalVolume(solidGasStrip,    // its solid
+				gasMat,           // its material
+				"Gas");           // its name
+	  logicGasStrip->SetVisAttributes(envelopeVisAttributes);
+
+	  // Gas placement
+	  G4VPhysicalVolume *gasReplicaStrip =
+	    new G4PVReplica("Gas",                  // name
+			    logicGasStrip,          // logical volume
+			    logicGasEnv,            // mother volume
+			    kXAxis,                 // replication axis
+			    nReplicasX,             // number of replicas
+			    plateSizeX);            // width
+
+	  G4VPhysicalVolume *gasReplica =
+	    new G4PVReplica("Gas",                  // name
+			    logicGas,               // logical volume
+			    gasReplicaStrip,        // mother volume
+			    kYAxis,                 // replication axis
+			    nReplicasY,             // number of replicas
+			    plateSizeY);            // width
+	}
+      else
+	{
+	  // Flat layout: the pads are placed directly in the faces and groups
+	  logicFaceEnv->SetSmartless(fSmartless);
+	  logicCentreGroup->SetSmartless(fSmartless);
+	  PlacePads(logicFaceEnv, faceThick, nFaceLayers, logicGas, logicPlate,
+		    nReplicasX, nReplicasY);
+	  PlacePads(logicCentreGroup, groupThick, nPerCentreGroup, logicGas, logicPlate,
+		    nReplicasX, nReplicasY);
+	}
+
+      // Field and readout of the pads
+      ConfigureReadout(logicGas, logicPlate);
 
       // // Test volume
       // G4Box *testBox = new G4Box("Gas", 5*m, 5*m, 27*mm);
@@ -456,7 +522,6 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
       // RPC layers - sizes, separations, material
       G4double layerSizeXY = 10*m;
       G4double layerSizeZ = 2*cm;
-      layerSep = 4*cm;
       G4double tripletSep = 1.55*m;
       G4Material *layerMat = nist->FindOrBuildMaterial("G4_Si");
 
@@ -576,3 +641,565 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::CheckOverlaps() const
+{
+  // Placements only, replicas tile their mother by construction and so do
+  // the pads of the flat layout
+  std::vector<G4VPhysicalVolume*> placements;
+  for(auto volume : *G4PhysicalVolumeStore::GetInstance())
+    {
+      if(!volume->GetMotherLogical() || volume->IsReplicated())
+	continue;
+      G4LogicalVolume* logical = volume->GetLogicalVolume();
+      if(fFlatLayout && (logical == fLogicGas || logical == fLogicPlate))
+	continue;
+      placements.push_back(volume);
+    }
+
+  B1OverlapCache cache(fOverlapCacheFile);
+  cache.Check(placements);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::PlacePads(G4LogicalVolume* logicMother, G4double motherThick,
+				       G4int nLayers, G4LogicalVolume* logicGas,
+				       G4LogicalVolume* logicPlate, G4int nStrips, G4int nPads)
+{
+  // Same positions as the replicas of the nested layout. The copy number is
+  // the channel ID within the face or group, so the readout does not have to
+  // decode the layer, cell, strip and pad from the touchable history. The
+  // pads tile the layers by construction, like replicas they are not checked
+  // for overlaps.
+  B1RPCLayout layout = GetLayout();
+  G4double rpcThick = layout.RPCThickness();
+  G4double plateZ = 0.5*rpcThick - 0.5*plateThick; // plate 0 at the back, 1 at the front
+  for(G4int nLayer=0; nLayer<nLayers; nLayer++)
+    {
+      G4double rpcZPos = layout.LayerZ(motherThick, nLayer);
+      for(G4int nStrip=0; nStrip<nStrips; nStrip++)
+	{
+	  G4double x = -0.5*detSizeXY + (nStrip + 0.5)*plateSizeX;
+	  for(G4int nPad=0; nPad<nPads; nPad++)
+	    {
+	      G4double y = -0.5*detSizeXY + (nPad + 0.5)*plateSizeY;
+
+	      new G4PVPlacement(0,                             // no rotation
+				G4ThreeVector(x, y, rpcZPos),  // middle of the RPC layer
+				logicGas,                      // its logical volume
+				"Gas",                         // its name
+				logicMother,                   // its mother  volume
+				false,                         // no boolean operation
+				B1ChannelID::Encode(0, nLayer, B1ChannelID::kGas, nStrip, nPad),
+				false);                        // overlaps checking
+
+	      for(G4int nPlate=0; nPlate<2; nPlate++)
+		new G4PVPlacement(0,                   // no rotation
+				  G4ThreeVector(x, y, rpcZPos + (nPlate==0 ? plateZ : -plateZ)),
+				  logicPlate,          // its logical volume
+				  "Plate",             // its name
+				  logicMother,         // its mother  volume
+				  false,               // no boolean operation
+				  B1ChannelID::Encode(0, nLayer, B1ChannelID::kPlate0 + nPlate,
+						      nStrip, nPad),
+				  false);              // overlaps checking
+	    }
+	}
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::ConfigureReadout(G4LogicalVolume* logicGas,
+					      G4LogicalVolume* logicPlate)
+{
+  // Visualisation settings
+  G4VisAttributes *gasVisAttributes = new G4VisAttributes(); // Make gas volume green
+  gasVisAttributes->SetColour(0., 1., 0.);
+  logicGas->SetVisAttributes(gasVisAttributes);
+
+  // Keep the readout volumes for the sensitive detectors
+  fLogicGas = logicGas;
+  fLogicPlate = logicPlate;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::ConfigureRegions(G4VPhysicalVolume* physWorld)
+{
+  // The volumes placed in the world (faces and centre volume, or silicon
+  // layers) are the roots of the Envelope region, the gas and plate pads
+  // those of their own regions
+  G4LogicalVolume* logicWorld = physWorld->GetLogicalVolume();
+  for(size_t i=0; i<logicWorld->GetNoDaughters(); i++)
+    {
+      G4LogicalVolume* envelope = logicWorld->GetDaughter(i)->GetLogicalVolume();
+      if(!envelope->IsRootRegion())
+	fEnvelopeRegion->AddRootLogicalVolume(envelope);
+    }
+  if(fLogicGas)
+    fGasRegion->AddRootLogicalVolume(fLogicGas);
+  if(fLogicPlate)
+    fPlateRegion->AddRootLogicalVolume(fLogicPlate);
+
+  // Step limits of the region of each volume
+  for(auto volume : *G4LogicalVolumeStore::GetInstance())
+    {
+      if(volume == fLogicGas)
+	volume->SetUserLimits(fGasLimits);
+      else if(volume == fLogicPlate)
+	volume->SetUserLimits(fPlateLimits);
+      else if(volume == logicWorld)
+	volume->SetUserLimits(fWorldLimits);
+      else
+	volume->SetUserLimits(fEnvelopeLimits);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::ReleaseRegions()
+{
+  // Detach the root volumes from the regions before the volumes are deleted
+  for(auto region : { fGasRegion, fPlateRegion, fEnvelopeRegion })
+    {
+      std::vector<G4LogicalVolume*> rootVolumes(region->GetRootLogicalVolumeIterator(),
+					       region->GetRootLogicalVolumeIterator()
+					       + region->GetNumberOfRootVolumes());
+      for(auto volume : rootVolumes)
+	region->RemoveRootLogicalVolume(volume, false);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VPhysicalVolume* B1DetectorConstruction::ReadGdml()
+{
+#ifdef G4LIB_USE_GDML
+  G4GDMLParser parser;
+  parser.Read(fGdmlReadFile, false);
+  G4VPhysicalVolume* physWorld = parser.GetWorldVolume();
+
+  // Field, step limits and sensitive detectors are not stored in the file,
+  // they go to the gas and plate pads: the volumes of that name without
+  // daughters (the envelopes and strips share their names)
+  G4LogicalVolume* logicGas = nullptr;
+  G4LogicalVolume* logicPlate = nullptr;
+  for(auto volume : *G4LogicalVolumeStore::GetInstance())
+    {
+      if(volume->GetNoDaughters() != 0)
+	continue;
+      if(volume->GetName() == "Gas")
+	logicGas = volume;
+      else if(volume->GetName() == "Plate")
+	logicPlate = volume;
+    }
+  if(logicGas && logicPlate)
+    ConfigureReadout(logicGas, logicPlate);
+
+  return physWorld;
+#else
+  G4ExceptionDescription msg;
+  msg << "Geant4 was built without GDML, cannot read " << fGdmlReadFile;
+  G4Exception("B1DetectorConstruction::ReadGdml()", "B1Geometry002",
+	      FatalException, msg);
+  return nullptr;
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::WriteGdml(const G4String& fileName) const
+{
+  G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()
+    ->GetNavigatorForTracking()->GetWorldVolume();
+  if(!world)
+    return;
+
+#ifdef G4LIB_USE_GDML
+  G4Timer timer;
+  timer.Start();
+  G4GDMLParser parser;
+  parser.Write(fileName, world);
+  timer.Stop();
+  G4cout << "Geometry written to " << fileName << " in "
+	 << timer.GetRealElapsed() << " s" << G4endl;
+#else
+  G4ExceptionDescription msg;
+  msg << "Geant4 was built without GDML, cannot write " << fileName;
+  G4Exception("B1DetectorConstruction::WriteGdml()", "B1Geometry002",
+	      JustWarning, msg);
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetGdmlReadFile(const G4String& fileName)
+{
+  fGdmlReadFile = fileName;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4Material* B1DetectorConstruction::GasMaterial()
+{
+  // The material is only built once, the geometry may be rebuilt between runs
+  G4Material *gasMat = G4Material::GetMaterial("rpcGas", false);
+  if(gasMat)
+    return gasMat;
+
+  G4NistManager* nist = G4NistManager::Instance();
+
+  // Convert between atomic mass units and kg, set Boltzmann constant in SI units
+  static const G4double amu = 1.66054e-27*kg;
+  G4double kBoltzmann = 1.38064582e-23*joule/kelvin;
+
+  // Gas parameters
+  G4double gasPressure = 100000*hep_pascal;
+      
+  // Gas components
+  G4Material *tetra = new G4Material("Tetrafluroethane", 4.25*kg/m3, 3, kStateGas);
+  tetra->AddElement(nist->FindOrBuildElement(6), 2);
+  tetra->AddElement(nist->FindOrBuildElement(1), 2);
+  tetra->AddElement(nist->FindOrBuildElement(9), 4);
+  G4double tetraMass = (2*12.0107 + 2*1.00784 + 4*18.998403)*amu; // Mass of tetrafluoroethane in kg
+  G4double tetraPercent = 94.7; // Percentage of mixture
+	
+  G4Material *butane = nist->FindOrBuildMaterial("G4_BUTANE"); // assuming butane and iso-butane have same properties - density matches
+  G4double butaneMass = (4*12.0107 + 10*1.00784)*amu; // Mass of butane in kg
+  G4double butanePercent = 5.0; // Percentage of mixture
+      
+  G4Material *sf6 = new G4Material("Sulphur Hexafluoride", 6.17*kg/m3, 2, kStateGas);
+  sf6->AddElement(nist->FindOrBuildElement(16), 1);
+  sf6->AddElement(nist->FindOrBuildElement(9), 6);
+  G4double sf6Mass = (32.065 + 6*18.998403)*amu; // Mass of SF6 in kg
+  G4double sf6Percent = 0.3; // Percentage of mixture
+
+  G4double averageMass = (tetraMass*tetraPercent + butaneMass*butanePercent + sf6Mass*sf6Percent)/100;
+  G4double gasDensity = (gasPressure*averageMass)/(kBoltzmann*CLHEP::STP_Temperature);
+  gasMat = new G4Material("rpcGas", gasDensity, 3, kStateGas, CLHEP::STP_Temperature, gasPressure);
+  gasMat->AddMaterial(tetra, tetraPercent*perCent);
+  gasMat->AddMaterial(butane, butanePercent*perCent);
+  gasMat->AddMaterial(sf6, sf6Percent*perCent);
+  std::cout << gasDensity/(kg/m3) << std::endl;
+
+  return gasMat;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::ConstructSDandField()
+{
+  // The silicon model has no RPC readout
+  if(!fLogicGas || !fLogicPlate)
+    return;
+
+  // Sensitive detectors for the gas cells and the plates, they are kept
+  // and attached to the new volumes when the geometry is rebuilt
+  G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+
+  B1RPCSensitiveDetector* gasSD = static_cast<B1RPCSensitiveDetector*>
+    (sdManager->FindSensitiveDetector("RPCGas", false));
+  if(!gasSD)
+    {
+      gasSD = new B1RPCSensitiveDetector("RPCGas", kRoleGas, this);
+      sdManager->AddNewDetector(gasSD);
+    }
+  SetSensitiveDetector(fLogicGas, gasSD);
+
+  B1RPCSensitiveDetector* plateSD = static_cast<B1RPCSensitiveDetector*>
+    (sdManager->FindSensitiveDetector("RPCPlate", false));
+  if(!plateSD)
+    {
+      plateSD = new B1RPCSensitiveDetector("RPCPlate", kRolePlate, this);
+      sdManager->AddNewDetector(plateSD);
+    }
+  SetSensitiveDetector(fLogicPlate, plateSD);
+
+  gasSD->SetPlateDetector(plateSD);
+
+  // Electric field of the gas. Each thread owns its field, equation,
+  // stepper and driver, deleted at the end of the thread; they are kept
+  // and attached to the new gas volume when the geometry is rebuilt.
+  B1ElectricFieldSetup* fieldSetup = fFieldSetup.Get();
+  if(!fieldSetup)
+    {
+      fieldSetup = new B1ElectricFieldSetup();
+      fieldSetup->SetParameters(fFieldParameters);
+      G4AutoDelete::Register(fieldSetup);
+      fFieldSetup.Put(fieldSetup);
+    }
+  fLogicGas->SetFieldManager(fieldSetup->GetLocalFieldManager(), false);
+
+  // Fast simulation model of the gas gap, one per thread; it is triggered
+  // only when enabled (/rpc/fast/gas)
+  if(!fGasRegion->GetFastSimulationManager())
+    new B1GasFastSimModel("GasClusters", fGasRegion, gasSD, &fClusterParameters);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetModel(const G4String& model)
+{
+  fSiliconModel = (model == "silicon");
+  fCodexb = (model == "codexb");
+
+  // RPC and overall detector parameters of the full size detector or of the
+  // demonstrator module, shared with the acceptance engine
+  B1RPCLayout layout = B1RPCLayout::Model(fCodexb ? "codexb" : "demonstrator");
+  gasThick = layout.gasThick*mm;
+  plateThick = layout.plateThick*mm;
+  plateSizeX = layout.padSizeX*mm;
+  plateSizeY = layout.padSizeY*mm;
+  layerSep = layout.layerSep*mm;
+  detSizeXY = layout.detSize*mm;
+  nFaceLayers = layout.nFaceLayers;
+  nPerCentreGroup = layout.nPerCentreGroup;
+  nCentreLayers = layout.nCentreGroups;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RPCLayout B1DetectorConstruction::GetLayout() const
+{
+  B1RPCLayout layout;
+  layout.detSize = detSizeXY/mm;
+  layout.gasThick = gasThick/mm;
+  layout.plateThick = plateThick/mm;
+  layout.padSizeX = plateSizeX/mm;
+  layout.padSizeY = plateSizeY/mm;
+  layout.layerSep = layerSep/mm;
+  layout.nFaceLayers = nFaceLayers;
+  layout.nPerCentreGroup = nPerCentreGroup;
+  layout.nCentreGroups = nCentreLayers;
+  return layout;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::WriteLayout(const G4String& fileName) const
+{
+  std::ofstream file(fileName);
+  GetLayout().Write(file);
+  G4cout << "RPC layout written to " << fileName << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetDetectorSize(G4double size)
+{
+  detSizeXY = size;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetGasThickness(G4double thickness)
+{
+  gasThick = thickness;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetPlateThickness(G4double thickness)
+{
+  plateThick = thickness;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetPadSizeX(G4double size)
+{
+  plateSizeX = size;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetPadSizeY(G4double size)
+{
+  plateSizeY = size;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetLayerSeparation(G4double separation)
+{
+  layerSep = separation;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetFaceLayers(G4int n)
+{
+  nFaceLayers = n;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetLayersPerGroup(G4int n)
+{
+  nPerCentreGroup = n;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetCentreGroups(G4int n)
+{
+  nCentreLayers = n;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetFlatLayout(G4bool flat)
+{
+  fFlatLayout = flat;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetSmartless(G4double smartless)
+{
+  fSmartless = smartless;
+  GeometryChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::BenchmarkNavigation(G4int nRays) const
+{
+  G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()
+    ->GetNavigatorForTracking()->GetWorldVolume();
+  if(!world)
+    return;
+
+  G4cout << G4endl << "Navigation benchmark of the "
+	 << (fFlatLayout ? "flat" : "nested") << " layout" << G4endl;
+  B1NavigationBenchmark benchmark(world);
+  benchmark.Run(nRays);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetFieldParameters(const B1FieldParameters& parameters)
+{
+  // The geometry is kept. The commands are handled by the master only, the
+  // workers take the parameters at the start of their next run
+  // (ApplyFieldParameters()); in sequential mode the field is updated now.
+  fFieldParameters = parameters;
+  ApplyFieldParameters();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::ApplyFieldParameters() const
+{
+  // Only what changed is rebuilt (B1ElectricFieldSetup::SetParameters())
+  if(fFieldSetup.Get())
+    fFieldSetup.Get()->SetParameters(fFieldParameters);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::BenchmarkField(G4int nEvents, G4int nElectrons)
+{
+  G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()
+    ->GetNavigatorForTracking()->GetWorldVolume();
+  if(!world || !fLogicGas)
+    return;
+
+  B1FieldBenchmark benchmark(this, world, fLogicGas);
+  benchmark.Run(nEvents, nElectrons);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetRegionCut(const G4String& regionName,
+					  const G4String& particleName, G4double cut)
+{
+  // A region without cuts of its own starts from the default cuts
+  G4Region* region = FindRegion(regionName);
+  G4ProductionCuts* cuts = region->GetProductionCuts();
+  if(!cuts)
+    {
+      cuts = new G4ProductionCuts(*G4ProductionCutsTable::GetProductionCutsTable()
+				  ->GetDefaultProductionCuts());
+      region->SetProductionCuts(cuts);
+    }
+
+  if(particleName == "all")
+    cuts->SetProductionCut(cut);
+  else
+    cuts->SetProductionCut(cut, particleName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetRegionStepLimit(const G4String& regionName,
+						const G4String& particleName, G4double limit)
+{
+  B1StepLimits* limits = fWorldLimits;
+  if(regionName == "RPCGas")
+    limits = fGasLimits;
+  else if(regionName == "RPCPlate")
+    limits = fPlateLimits;
+  else if(regionName == "Envelope")
+    limits = fEnvelopeLimits;
+
+  G4double maxStep = (limit > 0.) ? limit : DBL_MAX;
+  if(particleName == "all")
+    {
+      limits->SetMaxAllowedStep(maxStep);
+      return;
+    }
+
+  const G4ParticleDefinition* particle
+    = G4ParticleTable::GetParticleTable()->FindParticle(particleName);
+  if(!particle)
+    {
+      G4ExceptionDescription msg;
+      msg << "Unknown particle " << particleName << ", step limit not set";
+      G4Exception("B1DetectorConstruction::SetRegionStepLimit()", "B1Geometry003",
+		  JustWarning, msg);
+      return;
+    }
+  limits->SetMaxAllowedStep(particle, maxStep);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4Region* B1DetectorConstruction::FindRegion(const G4String& regionName) const
+{
+  if(regionName == "RPCGas")
+    return fGasRegion;
+  if(regionName == "RPCPlate")
+    return fPlateRegion;
+  if(regionName == "Envelope")
+    return fEnvelopeRegion;
+  return G4RegionStore::GetInstance()->GetRegion("DefaultRegionForTheWorld", false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::GeometryChanged()
+{
+  // Before initialisation the geometry is simply built with the new values.
+  // Afterwards it is rebuilt before the next run, the command is passed on
+  // to the worker threads so that they attach their sensitive detectors to
+  // the new volumes.
+  if(G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle)
+    G4UImanager::GetUIpointer()->ApplyCommand("/run/reinitializeGeometry");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
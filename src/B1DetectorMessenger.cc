@@ -0,0 +1,618 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1DetectorMessenger.cc
+/// \brief Implementation of the B1DetectorMessenger class
+
+#include "B1DetectorMessenger.hh"
+#include "B1DetectorConstruction.hh"
+#include "B1FieldMap.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWith3Vector.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <sstream>
+#include <string>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DetectorMessenger::B1DetectorMessenger(B1DetectorConstruction* det)
+ : G4UImessenger(),
+   fDetectorConstruction(det)
+{
+  fRpcDirectory = new G4UIdirectory("/rpc/");
+  fRpcDirectory->SetGuidance("UI commands of the RPC simulation");
+
+  fReadoutDirectory = new G4UIdirectory("/rpc/readout/");
+  fReadoutDirectory->SetGuidance("RPC readout control");
+
+  fAggregateCmd = new G4UIcmdWithABool("/rpc/readout/aggregate",this);
+  fAggregateCmd->SetGuidance("Merge consecutive steps of a track in the same");
+  fAggregateCmd->SetGuidance("gas or plate cell into a single hit. Fixed at the first");
+  fAggregateCmd->SetGuidance("run with the ntuple columns.");
+  fAggregateCmd->SetParameterName("aggregate",false);
+  fAggregateCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fAggregateCmd->SetToBeBroadcasted(false);
+
+  // Geometry commands, changes after initialisation rebuild the geometry
+  // before the next run
+  fGeometryDirectory = new G4UIdirectory("/rpc/geometry/");
+  fGeometryDirectory->SetGuidance("RPC detector geometry");
+
+  fModelCmd = new G4UIcmdWithAString("/rpc/geometry/model",this);
+  fModelCmd->SetGuidance("Select the detector model, resets the layout to its defaults.");
+  fModelCmd->SetParameterName("model",false);
+  fModelCmd->SetCandidates("codexb demonstrator silicon");
+  fModelCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fModelCmd->SetToBeBroadcasted(false);
+
+  fSizeCmd = NewLengthCommand("/rpc/geometry/size",
+			      "Side of the detector cube and of the RPC layers.");
+  fGasThicknessCmd = NewLengthCommand("/rpc/geometry/gasThickness",
+				      "Thickness of the RPC gas gap.");
+  fPlateThicknessCmd = NewLengthCommand("/rpc/geometry/plateThickness",
+					"Thickness of the RPC plates.");
+  fPadSizeXCmd = NewLengthCommand("/rpc/geometry/padSizeX",
+				  "Pad size along x, must divide the detector size.");
+  fPadSizeYCmd = NewLengthCommand("/rpc/geometry/padSizeY",
+				  "Pad size along y, must divide the detector size.");
+  fLayerSeparationCmd = NewLengthCommand("/rpc/geometry/layerSeparation",
+					 "Distance between the surfaces of neighbouring RPCs.");
+
+  // Limits of the layer and station fields of the channel IDs
+  fFaceLayersCmd = NewCountCommand("/rpc/geometry/faceLayers",
+				   "Number of RPC layers on each face.",
+				   "n>=1 && n<=16");
+  fLayersPerGroupCmd = NewCountCommand("/rpc/geometry/layersPerGroup",
+				       "Number of RPC layers in each centre group.",
+				       "n>=1 && n<=16");
+  fCentreGroupsCmd = NewCountCommand("/rpc/geometry/centreGroups",
+				     "Number of RPC groups in the centre volume.",
+				     "n>=0 && n<=10");
+
+  fFlatCmd = new G4UIcmdWithABool("/rpc/geometry/flat",this);
+  fFlatCmd->SetGuidance("Place the gas and plate pads directly in the faces and");
+  fFlatCmd->SetGuidance("centre groups instead of the nested RPC envelopes and");
+  fFlatCmd->SetGuidance("strip replicas. Materials and readout cells are the same.");
+  fFlatCmd->SetParameterName("flat",false);
+  fFlatCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFlatCmd->SetToBeBroadcasted(false);
+
+  fSmartlessCmd = new G4UIcmdWithADouble("/rpc/geometry/smartless",this);
+  fSmartlessCmd->SetGuidance("Voxelisation quality of the faces and groups in the flat");
+  fSmartlessCmd->SetGuidance("layout, the average number of voxels per pad (default 2).");
+  fSmartlessCmd->SetParameterName("smartless",false);
+  fSmartlessCmd->SetRange("smartless>0.");
+  fSmartlessCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSmartlessCmd->SetToBeBroadcasted(false);
+
+  fBenchmarkCmd = new G4UIcmdWithAnInteger("/rpc/geometry/benchmark",this);
+  fBenchmarkCmd->SetGuidance("Time the navigation of straight rays through the");
+  fBenchmarkCmd->SetGuidance("geometry of the last run, with the RPC step limits.");
+  fBenchmarkCmd->SetParameterName("nRays",true);
+  fBenchmarkCmd->SetDefaultValue(1000);
+  fBenchmarkCmd->SetRange("nRays>0");
+  fBenchmarkCmd->AvailableForStates(G4State_Idle);
+  fBenchmarkCmd->SetToBeBroadcasted(false);
+
+  fCheckOverlapsCmd = new G4UIcmdWithABool("/rpc/geometry/checkOverlaps",this);
+  fCheckOverlapsCmd->SetGuidance("Check the placements for overlaps when the geometry is built.");
+  fCheckOverlapsCmd->SetGuidance("A geometry found in the overlap cache is not checked again.");
+  fCheckOverlapsCmd->SetParameterName("check",false);
+  fCheckOverlapsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fCheckOverlapsCmd->SetToBeBroadcasted(false);
+
+  fOverlapCacheCmd = new G4UIcmdWithAString("/rpc/geometry/overlapCache",this);
+  fOverlapCacheCmd->SetGuidance("File of the overlap check results, keyed on a hash of the");
+  fOverlapCacheCmd->SetGuidance("placed geometry (default overlaps.cache).");
+  fOverlapCacheCmd->SetGuidance("An empty name always runs the check.");
+  fOverlapCacheCmd->SetParameterName("fileName",true);
+  fOverlapCacheCmd->SetDefaultValue("");
+  fOverlapCacheCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fOverlapCacheCmd->SetToBeBroadcasted(false);
+
+  fWriteLayoutCmd = new G4UIcmdWithAString("/rpc/geometry/writeLayout",this);
+  fWriteLayoutCmd->SetGuidance("Write the parameters of the RPC layers for the standalone");
+  fWriteLayoutCmd->SetGuidance("acceptance engine (tools/acceptance).");
+  fWriteLayoutCmd->SetParameterName("fileName",false);
+  fWriteLayoutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fWriteLayoutCmd->SetToBeBroadcasted(false);
+
+  fGdmlDirectory = new G4UIdirectory("/rpc/geometry/gdml/");
+  fGdmlDirectory->SetGuidance("GDML export and import of the geometry");
+
+  fGdmlReadCmd = new G4UIcmdWithAString("/rpc/geometry/gdml/read",this);
+  fGdmlReadCmd->SetGuidance("Read the geometry from a GDML file instead of building it.");
+  fGdmlReadCmd->SetGuidance("Without a file name the geometry is built again.");
+  fGdmlReadCmd->SetParameterName("fileName",true);
+  fGdmlReadCmd->SetDefaultValue("");
+  fGdmlReadCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fGdmlReadCmd->SetToBeBroadcasted(false);
+
+  fGdmlWriteCmd = new G4UIcmdWithAString("/rpc/geometry/gdml/write",this);
+  fGdmlWriteCmd->SetGuidance("Write the geometry of the last run, materials included,");
+  fGdmlWriteCmd->SetGuidance("to a GDML file. An existing file is not overwritten.");
+  fGdmlWriteCmd->SetParameterName("fileName",false);
+  fGdmlWriteCmd->AvailableForStates(G4State_Idle);
+  fGdmlWriteCmd->SetToBeBroadcasted(false);
+
+  // Production cuts and step limits of the regions
+  fRegionDirectory = new G4UIdirectory("/rpc/region/");
+  fRegionDirectory->SetGuidance("Production cuts and step limits of the RPCGas, RPCPlate,");
+  fRegionDirectory->SetGuidance("Envelope and World regions (see /run/dumpRegion).");
+
+  fRegionCutCmd = NewRegionCommand("/rpc/region/cut", "gamma e- e+ proton all");
+  fRegionCutCmd->SetGuidance("Production cut of a particle in a region, or of all four.");
+  fRegionCutCmd->SetGuidance("A region without cuts of its own starts from the default cuts,");
+  fRegionCutCmd->SetGuidance("the World cuts are the default cuts.");
+
+  fRegionStepLimitCmd = NewRegionCommand("/rpc/region/stepLimit", "");
+  fRegionStepLimitCmd->SetGuidance("Maximum step of a charged particle in a region, \"all\" for");
+  fRegionStepLimitCmd->SetGuidance("the particles without their own limit. 0 removes the limit.");
+  fRegionStepLimitCmd->SetGuidance("By default charged particles are limited to 0.01 mm in RPCGas.");
+
+  // Fast simulation of the gas gap, the parameters are read by the models
+  // of all threads at each track
+  fFastDirectory = new G4UIdirectory("/rpc/fast/");
+  fFastDirectory->SetGuidance("Fast simulation of the RPC gas gap");
+
+  fFastGasCmd = new G4UIcmdWithABool("/rpc/fast/gas",this);
+  fFastGasCmd->SetGuidance("Sample the primary clusters along the chord of charged");
+  fFastGasCmd->SetGuidance("particles through the gas instead of transporting them.");
+  fFastGasCmd->SetGuidance("Off, the default, is the step limited transport.");
+  fFastGasCmd->SetParameterName("fast",false);
+  fFastGasCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFastGasCmd->SetToBeBroadcasted(false);
+
+  fClusterDensityCmd = new G4UIcmdWithADouble("/rpc/fast/clusterDensity",this);
+  fClusterDensityCmd->SetGuidance("Mean number of primary clusters per mm (default 9.5).");
+  fClusterDensityCmd->SetParameterName("density",false);
+  fClusterDensityCmd->SetRange("density>0.");
+  fClusterDensityCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fClusterDensityCmd->SetToBeBroadcasted(false);
+
+  fSingleFractionCmd = new G4UIcmdWithADouble("/rpc/fast/singleFraction",this);
+  fSingleFractionCmd->SetGuidance("Fraction of clusters with a single electron (default 0.75),");
+  fSingleFractionCmd->SetGuidance("the larger sizes follow a 1/n^2 tail.");
+  fSingleFractionCmd->SetParameterName("fraction",false);
+  fSingleFractionCmd->SetRange("fraction>=0. && fraction<=1.");
+  fSingleFractionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSingleFractionCmd->SetToBeBroadcasted(false);
+
+  fIonisationEnergyCmd = new G4UIcmdWithADoubleAndUnit("/rpc/fast/ionisationEnergy",this);
+  fIonisationEnergyCmd->SetGuidance("Mean energy per electron-ion pair (default 30 eV).");
+  fIonisationEnergyCmd->SetParameterName("energy",false);
+  fIonisationEnergyCmd->SetRange("energy>0.");
+  fIonisationEnergyCmd->SetUnitCategory("Energy");
+  fIonisationEnergyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fIonisationEnergyCmd->SetToBeBroadcasted(false);
+
+  fMinBetaGammaCmd = new G4UIcmdWithADouble("/rpc/fast/minBetaGamma",this);
+  fMinBetaGammaCmd->SetGuidance("Slower particles are transported through the gas (default 3).");
+  fMinBetaGammaCmd->SetParameterName("betaGamma",false);
+  fMinBetaGammaCmd->SetRange("betaGamma>=0.");
+  fMinBetaGammaCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fMinBetaGammaCmd->SetToBeBroadcasted(false);
+
+  // Integration of the gas field
+  fFieldDirectory = new G4UIdirectory("/rpc/field/");
+  fFieldDirectory->SetGuidance("Electric field of the RPC gas gap");
+
+  fStepperCmd = new G4UIcmdWithAnInteger("/rpc/field/stepper",this);
+  fStepperCmd->SetGuidance("Stepper of the field propagation in the gas:");
+  fStepperCmd->SetGuidance(" 0 ExplicitEuler, 1 ImplicitEuler, 2 SimpleRunge,");
+  fStepperCmd->SetGuidance(" 3 SimpleHeum, 4 ClassicalRK4 (default), 5 CashKarpRKF45,");
+  fStepperCmd->SetGuidance(" 10 exact solution in the uniform field, 11 DormandPrince745,");
+  fStepperCmd->SetGuidance(" 12 BogackiShampine45, 13 TsitourasRK45.");
+  fStepperCmd->SetParameterName("type",false);
+  fStepperCmd->SetRange("type>=0 && type<=5 || type>=10 && type<=13");
+  fStepperCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fStepperCmd->SetToBeBroadcasted(false);
+
+  fMinStepCmd = NewLengthCommand("/rpc/field/minStep",
+				 "Minimum step of the integration driver (default 0.01 mm).");
+
+  fDeltaChordCmd = NewLengthCommand("/rpc/field/deltaChord",
+				    "Maximum miss distance of the chords (default 0.25 mm).");
+
+  fDeltaOneStepCmd = NewLengthCommand("/rpc/field/deltaOneStep",
+				      "Accuracy of the endpoint of a step (default 0.01 mm).");
+
+  fDeltaIntersectionCmd = NewLengthCommand("/rpc/field/deltaIntersection",
+					   "Accuracy of the boundary crossings (default 0.001 mm).");
+
+  fEpsilonMinCmd = new G4UIcmdWithADouble("/rpc/field/epsilonMin",this);
+  fEpsilonMinCmd->SetGuidance("Lower bound of the relative accuracy of a step (default 5e-5).");
+  fEpsilonMinCmd->SetGuidance("A value above epsilonMax is rejected.");
+  fEpsilonMinCmd->SetParameterName("epsilon",false);
+  fEpsilonMinCmd->SetRange("epsilon>0. && epsilon<1.");
+  fEpsilonMinCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEpsilonMinCmd->SetToBeBroadcasted(false);
+
+  fEpsilonMaxCmd = new G4UIcmdWithADouble("/rpc/field/epsilonMax",this);
+  fEpsilonMaxCmd->SetGuidance("Upper bound of the relative accuracy of a step (default 1e-3).");
+  fEpsilonMaxCmd->SetGuidance("A value below epsilonMin is rejected.");
+  fEpsilonMaxCmd->SetParameterName("epsilon",false);
+  fEpsilonMaxCmd->SetRange("epsilon>0. && epsilon<1.");
+  fEpsilonMaxCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEpsilonMaxCmd->SetToBeBroadcasted(false);
+
+  fTrackModeCmd = new G4UIcommand("/rpc/field/trackMode",this);
+  fTrackModeCmd->SetGuidance("Propagation in the gas field of the tracks of a particle,");
+  fTrackModeCmd->SetGuidance("or of all particles without their own rule, above a momentum:");
+  fTrackModeCmd->SetGuidance(" integrate with the field accuracy (the default, removes the rule),");
+  fTrackModeCmd->SetGuidance(" coarse accuracy, or straight lines ignoring the field.");
+  G4UIparameter* particlePrm = new G4UIparameter("particle",'s',false);
+  fTrackModeCmd->SetParameter(particlePrm);
+  G4UIparameter* momentumPrm = new G4UIparameter("momentum",'d',false);
+  momentumPrm->SetParameterRange("momentum>=0.");
+  fTrackModeCmd->SetParameter(momentumPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',false);
+  unitPrm->SetDefaultUnit("GeV");
+  fTrackModeCmd->SetParameter(unitPrm);
+  G4UIparameter* modePrm = new G4UIparameter("mode",'s',false);
+  modePrm->SetParameterCandidates("integrate coarse straight");
+  fTrackModeCmd->SetParameter(modePrm);
+  fTrackModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fTrackModeCmd->SetToBeBroadcasted(false);
+
+  fFieldMapCmd = new G4UIcmdWithAString("/rpc/field/map",this);
+  fFieldMapCmd->SetGuidance("Gridded electric field map of the gas (B1FieldMap file,");
+  fFieldMapCmd->SetGuidance("global coordinates, kV/cm), the uniform field outside the grid.");
+  fFieldMapCmd->SetGuidance("An empty name restores the uniform field, a file that cannot");
+  fFieldMapCmd->SetGuidance("be read keeps the previous field.");
+  fFieldMapCmd->SetParameterName("fileName",true);
+  fFieldMapCmd->SetDefaultValue("");
+  fFieldMapCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFieldMapCmd->SetToBeBroadcasted(false);
+
+  fFieldValueCmd = new G4UIcmdWith3Vector("/rpc/field/value",this);
+  fFieldValueCmd->SetGuidance("Uniform electric field of the gas in kV/cm (default 0 0 -54),");
+  fFieldValueCmd->SetGuidance("also used outside a field map. Applied by every thread at");
+  fFieldValueCmd->SetGuidance("the next run, without rebuilding the geometry, for HV scans.");
+  fFieldValueCmd->SetParameterName("Ex","Ey","Ez",false);
+  fFieldValueCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fFieldValueCmd->SetToBeBroadcasted(false);
+
+  fFieldBenchmarkCmd = new G4UIcommand("/rpc/field/benchmark",this);
+  fFieldBenchmarkCmd->SetGuidance("Run the same events and propagate the same gas electrons");
+  fFieldBenchmarkCmd->SetGuidance("for a set of steppers and accuracies, and print the");
+  fFieldBenchmarkCmd->SetGuidance("events/s, electrons/s and electron endpoint errors.");
+  G4UIparameter* eventsPrm = new G4UIparameter("nEvents",'i',true);
+  eventsPrm->SetDefaultValue(100);
+  eventsPrm->SetParameterRange("nEvents>=0");
+  fFieldBenchmarkCmd->SetParameter(eventsPrm);
+  G4UIparameter* electronsPrm = new G4UIparameter("nElectrons",'i',true);
+  electronsPrm->SetDefaultValue(10000);
+  electronsPrm->SetParameterRange("nElectrons>0");
+  fFieldBenchmarkCmd->SetParameter(electronsPrm);
+  fFieldBenchmarkCmd->AvailableForStates(G4State_Idle);
+  fFieldBenchmarkCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIcmdWithADoubleAndUnit*
+B1DetectorMessenger::NewLengthCommand(const char* name, const char* guidance)
+{
+  G4UIcmdWithADoubleAndUnit* command = new G4UIcmdWithADoubleAndUnit(name,this);
+  command->SetGuidance(guidance);
+  command->SetParameterName("length",false);
+  command->SetRange("length>0.");
+  command->SetUnitCategory("Length");
+  command->AvailableForStates(G4State_PreInit, G4State_Idle);
+  command->SetToBeBroadcasted(false);
+  return command;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIcmdWithAnInteger*
+B1DetectorMessenger::NewCountCommand(const char* name, const char* guidance,
+				     const char* range)
+{
+  G4UIcmdWithAnInteger* command = new G4UIcmdWithAnInteger(name,this);
+  command->SetGuidance(guidance);
+  command->SetParameterName("n",false);
+  command->SetRange(range);
+  command->AvailableForStates(G4State_PreInit, G4State_Idle);
+  command->SetToBeBroadcasted(false);
+  return command;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIcommand* B1DetectorMessenger::NewRegionCommand(const char* name, const char* particles)
+{
+  G4UIcommand* command = new G4UIcommand(name,this);
+
+  G4UIparameter* regionPrm = new G4UIparameter("region",'s',false);
+  regionPrm->SetParameterCandidates("RPCGas RPCPlate Envelope World");
+  command->SetParameter(regionPrm);
+
+  G4UIparameter* particlePrm = new G4UIparameter("particle",'s',false);
+  if(*particles)
+    particlePrm->SetParameterCandidates(particles);
+  command->SetParameter(particlePrm);
+
+  G4UIparameter* valuePrm = new G4UIparameter("value",'d',false);
+  valuePrm->SetParameterRange("value>=0.");
+  command->SetParameter(valuePrm);
+
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("mm");
+  command->SetParameter(unitPrm);
+
+  command->AvailableForStates(G4State_PreInit, G4State_Idle);
+  command->SetToBeBroadcasted(false);
+  return command;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DetectorMessenger::~B1DetectorMessenger()
+{
+  delete fAggregateCmd;
+  delete fModelCmd;
+  delete fSizeCmd;
+  delete fGasThicknessCmd;
+  delete fPlateThicknessCmd;
+  delete fPadSizeXCmd;
+  delete fPadSizeYCmd;
+  delete fLayerSeparationCmd;
+  delete fFaceLayersCmd;
+  delete fLayersPerGroupCmd;
+  delete fCentreGroupsCmd;
+  delete fFlatCmd;
+  delete fSmartlessCmd;
+  delete fBenchmarkCmd;
+  delete fCheckOverlapsCmd;
+  delete fOverlapCacheCmd;
+  delete fWriteLayoutCmd;
+  delete fGdmlReadCmd;
+  delete fGdmlWriteCmd;
+  delete fRegionCutCmd;
+  delete fRegionStepLimitCmd;
+  delete fFastGasCmd;
+  delete fClusterDensityCmd;
+  delete fSingleFractionCmd;
+  delete fIonisationEnergyCmd;
+  delete fMinBetaGammaCmd;
+  delete fStepperCmd;
+  delete fMinStepCmd;
+  delete fDeltaChordCmd;
+  delete fDeltaOneStepCmd;
+  delete fDeltaIntersectionCmd;
+  delete fEpsilonMinCmd;
+  delete fEpsilonMaxCmd;
+  delete fTrackModeCmd;
+  delete fFieldMapCmd;
+  delete fFieldValueCmd;
+  delete fFieldBenchmarkCmd;
+  delete fFieldDirectory;
+  delete fFastDirectory;
+  delete fRegionDirectory;
+  delete fGdmlDirectory;
+  delete fGeometryDirectory;
+  delete fReadoutDirectory;
+  delete fRpcDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if( command == fAggregateCmd ) {
+    fDetectorConstruction
+      ->SetAggregateHits(fAggregateCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fModelCmd ) {
+    fDetectorConstruction->SetModel(newValue);
+  }
+  else if( command == fSizeCmd ) {
+    fDetectorConstruction
+      ->SetDetectorSize(fSizeCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fGasThicknessCmd ) {
+    fDetectorConstruction
+      ->SetGasThickness(fGasThicknessCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fPlateThicknessCmd ) {
+    fDetectorConstruction
+      ->SetPlateThickness(fPlateThicknessCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fPadSizeXCmd ) {
+    fDetectorConstruction
+      ->SetPadSizeX(fPadSizeXCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fPadSizeYCmd ) {
+    fDetectorConstruction
+      ->SetPadSizeY(fPadSizeYCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fLayerSeparationCmd ) {
+    fDetectorConstruction
+      ->SetLayerSeparation(fLayerSeparationCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fFaceLayersCmd ) {
+    fDetectorConstruction
+      ->SetFaceLayers(fFaceLayersCmd->GetNewIntValue(newValue));
+  }
+  else if( command == fLayersPerGroupCmd ) {
+    fDetectorConstruction
+      ->SetLayersPerGroup(fLayersPerGroupCmd->GetNewIntValue(newValue));
+  }
+  else if( command == fCentreGroupsCmd ) {
+    fDetectorConstruction
+      ->SetCentreGroups(fCentreGroupsCmd->GetNewIntValue(newValue));
+  }
+  else if( command == fFlatCmd ) {
+    fDetectorConstruction
+      ->SetFlatLayout(fFlatCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fSmartlessCmd ) {
+    fDetectorConstruction
+      ->SetSmartless(fSmartlessCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fBenchmarkCmd ) {
+    fDetectorConstruction
+      ->BenchmarkNavigation(fBenchmarkCmd->GetNewIntValue(newValue));
+  }
+  else if( command == fCheckOverlapsCmd ) {
+    fDetectorConstruction
+      ->SetCheckOverlaps(fCheckOverlapsCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fOverlapCacheCmd ) {
+    fDetectorConstruction->SetOverlapCacheFile(newValue);
+  }
+  else if( command == fWriteLayoutCmd ) {
+    fDetectorConstruction->WriteLayout(newValue);
+  }
+  else if( command == fGdmlReadCmd ) {
+    fDetectorConstruction->SetGdmlReadFile(newValue);
+  }
+  else if( command == fGdmlWriteCmd ) {
+    fDetectorConstruction->WriteGdml(newValue);
+  }
+  else if( command == fRegionCutCmd || command == fRegionStepLimitCmd ) {
+    G4String region, particle, unit;
+    G4double value;
+    std::istringstream is(newValue);
+    is >> region >> particle >> value >> unit;
+    value *= G4UIcommand::ValueOf(unit);
+    if( command == fRegionCutCmd )
+      fDetectorConstruction->SetRegionCut(region, particle, value);
+    else
+      fDetectorConstruction->SetRegionStepLimit(region, particle, value);
+  }
+  else if( command == fFastGasCmd ) {
+    fDetectorConstruction->GetClusterParameters().enabled
+      = fFastGasCmd->GetNewBoolValue(newValue);
+  }
+  else if( command == fClusterDensityCmd ) {
+    fDetectorConstruction->GetClusterParameters().clusterDensity
+      = fClusterDensityCmd->GetNewDoubleValue(newValue)/mm;
+  }
+  else if( command == fSingleFractionCmd ) {
+    fDetectorConstruction->GetClusterParameters().singleFraction
+      = fSingleFractionCmd->GetNewDoubleValue(newValue);
+  }
+  else if( command == fIonisationEnergyCmd ) {
+    fDetectorConstruction->GetClusterParameters().ionisationEnergy
+      = fIonisationEnergyCmd->GetNewDoubleValue(newValue);
+  }
+  else if( command == fMinBetaGammaCmd ) {
+    fDetectorConstruction->GetClusterParameters().minBetaGamma
+      = fMinBetaGammaCmd->GetNewDoubleValue(newValue);
+  }
+  else if( command == fStepperCmd || command == fMinStepCmd
+	   || command == fDeltaChordCmd || command == fDeltaOneStepCmd
+	   || command == fDeltaIntersectionCmd
+	   || command == fEpsilonMinCmd || command == fEpsilonMaxCmd
+	   || command == fTrackModeCmd || command == fFieldMapCmd
+	   || command == fFieldValueCmd ) {
+    B1FieldParameters parameters = fDetectorConstruction->GetFieldParameters();
+    if( command == fStepperCmd )
+      parameters.stepperType = fStepperCmd->GetNewIntValue(newValue);
+    else if( command == fMinStepCmd )
+      parameters.minStep = fMinStepCmd->GetNewDoubleValue(newValue);
+    else if( command == fDeltaChordCmd )
+      parameters.deltaChord = fDeltaChordCmd->GetNewDoubleValue(newValue);
+    else if( command == fDeltaOneStepCmd )
+      parameters.deltaOneStep = fDeltaOneStepCmd->GetNewDoubleValue(newValue);
+    else if( command == fDeltaIntersectionCmd )
+      parameters.deltaIntersection = fDeltaIntersectionCmd->GetNewDoubleValue(newValue);
+    else if( command == fEpsilonMinCmd )
+      parameters.epsilonMin = fEpsilonMinCmd->GetNewDoubleValue(newValue);
+    else if( command == fEpsilonMaxCmd )
+      parameters.epsilonMax = fEpsilonMaxCmd->GetNewDoubleValue(newValue);
+    else if( command == fFieldMapCmd ) {
+      // Checked once here, so that a bad file keeps the previous field
+      // instead of failing in the field of every thread
+      if( !newValue.empty() ) {
+	B1FieldMap map;
+	std::string error;
+	if( !map.Open(newValue, error) ) {
+	  G4ExceptionDescription msg;
+	  msg << "Field map " << newValue << " not loaded: " << error
+	      << ", the previous field is kept";
+	  G4Exception("B1DetectorMessenger::SetNewValue()", "B1Field004",
+		      JustWarning, msg);
+	  return;
+	}
+      }
+      parameters.fieldMap = newValue;
+    }
+    else if( command == fFieldValueCmd )
+      parameters.fieldValue
+	= fFieldValueCmd->GetNew3VectorValue(newValue)*(kilovolt/cm);
+    else {
+      // Replace the rule of the particle, integrated tracks need none
+      G4String particle, unit, mode;
+      G4double momentum;
+      std::istringstream is(newValue);
+      is >> particle >> momentum >> unit >> mode;
+      std::vector<B1FieldTrackRule>& rules = parameters.trackRules;
+      for(size_t i=0; i<rules.size(); i++)
+	if(rules[i].particle == particle) {
+	  rules.erase(rules.begin() + i);
+	  break;
+	}
+      if( mode != "integrate" ) {
+	B1FieldTrackRule rule;
+	rule.particle = particle;
+	rule.minMomentum = momentum*G4UIcommand::ValueOf(unit);
+	rule.mode = (mode == "coarse") ? kFieldCoarse : kFieldStraight;
+	rules.push_back(rule);
+      }
+    }
+    // Crossed accuracy bounds would reach the field manager of every thread
+    if( parameters.epsilonMin > parameters.epsilonMax ) {
+      G4ExceptionDescription msg;
+      msg << "epsilonMin " << parameters.epsilonMin << " above epsilonMax "
+	  << parameters.epsilonMax << ", the previous accuracy bounds are kept";
+      G4Exception("B1DetectorMessenger::SetNewValue()", "B1Field005",
+		  JustWarning, msg);
+      return;
+    }
+    fDetectorConstruction->SetFieldParameters(parameters);
+  }
+  else if( command == fFieldBenchmarkCmd ) {
+    G4int nEvents = 0, nElectrons = 0;
+    std::istringstream is(newValue);
+    is >> nEvents >> nElectrons;
+    fDetectorConstruction->BenchmarkField(nEvents, nElectrons);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -35,6 +35,10 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 #include "B1ElectricFieldSetup.hh"
+#include "B1EqElectricField.hh"
+#include "B1UniformElectricStepper.hh"
+#include "B1GasFieldManager.hh"
+#include "B1GriddedElectricField.hh"
 
 #include "G4UniformElectricField.hh"
 #include "G4UniformMagField.hh"
@@ -57,6 +61,9 @@
 #include "G4HelixImplicitEuler.hh"
 #include "G4HelixSimpleRunge.hh"
 #include "G4CashKarpRKF45.hh"
+#include "G4DormandPrince745.hh"
+#include "G4BogackiShampine45.hh"
+#include "G4TsitourasRK45.hh"
 #include "G4RKG3_Stepper.hh"
 
 #include "G4PhysicalConstants.hh"
@@ -72,16 +79,16 @@ B1ElectricFieldSetup::B1ElectricFieldSetup()
    fChordFinder(0),
    fEquation(0),
    fEMfield(0),
-   fElFieldValue(),
+   fElFieldValue(0.0,0.0,-54*kilovolt/cm), // Default is -54
+   fFieldMap(),
    fStepper(0),
    fIntgrDriver(0),
    fStepperType(4)     // ClassicalRK4 -- the default stepper
 {
-  fEMfield = new G4UniformElectricField(
-					G4ThreeVector(0.0,0.0,-54*kilovolt/cm)); // Default is -54
-  fEquation = new G4EqMagElectricField(fEMfield);
+  fEMfield = new G4UniformElectricField(fElFieldValue);
+  fEquation = new B1EqElectricField(fEMfield);
 
-  fFieldManager = new G4FieldManager();
+  fFieldManager = new B1GasFieldManager();
 
   UpdateIntegrator();
 }
@@ -94,15 +101,16 @@ B1ElectricFieldSetup::B1ElectricFieldSetup(G4ThreeVector fieldVector)
     fChordFinder(0),
     fEquation(0),
     fEMfield(0),
-    fElFieldValue(),
+    fElFieldValue(fieldVector),
+    fFieldMap(),
     fStepper(0),
     fIntgrDriver(0),
     fStepperType(4)     // ClassicalRK4 -- the default stepper
 {
   fEMfield = new G4UniformElectricField(fieldVector);
-  fEquation = new G4EqMagElectricField(fEMfield);
+  fEquation = new B1EqElectricField(fEMfield);
 
-  fFieldManager = new G4FieldManager();
+  fFieldManager = new B1GasFieldManager();
   UpdateIntegrator();
   
 }
@@ -112,6 +120,7 @@ B1ElectricFieldSetup::B1ElectricFieldSetup(G4ThreeVector fieldVector)
 B1ElectricFieldSetup::~B1ElectricFieldSetup()
 {
   // G4cout << " B1ElectricFieldSetup - dtor called. " << G4endl;
+  delete fFieldManager; fFieldManager = nullptr;
   delete fChordFinder;  fChordFinder= nullptr;
   delete fStepper;      fStepper = nullptr;
   delete fEquation;     fEquation = nullptr;
@@ -165,7 +174,8 @@ void B1ElectricFieldSetup::UpdateIntegrator()
   }
 
   fFieldManager->SetChordFinder(fChordFinder);
-  fFieldManager->SetDetectorField(fEMfield);
+  G4bool zeroField = fFieldMap.empty() && fElFieldValue == G4ThreeVector();
+  fFieldManager->SetGasField(zeroField ? nullptr : fEMfield);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -222,6 +232,22 @@ void B1ElectricFieldSetup::CreateStepper()
       fStepper = 0; // new G4HelixSimpleRunge( fEquation );
       G4cout<<"G4HelixSimpleRunge is not valid for Electric Field"<<G4endl;
       break;
+    case 10:
+      fStepper = new B1UniformElectricStepper( fEquation, nvar );
+      G4cout<<"B1UniformElectricStepper is called"<<G4endl;
+      break;
+    case 11:
+      fStepper = new G4DormandPrince745( fEquation, nvar );
+      G4cout<<"G4DormandPrince745 is called"<<G4endl;
+      break;
+    case 12:
+      fStepper = new G4BogackiShampine45( fEquation, nvar );
+      G4cout<<"G4BogackiShampine45 is called"<<G4endl;
+      break;
+    case 13:
+      fStepper = new G4TsitourasRK45( fEquation, nvar );
+      G4cout<<"G4TsitourasRK45 is called"<<G4endl;
+      break;
     default:  /* fStepper = 0; // Older code */
       fStepper = new G4ClassicalRK4( fEquation, nvar );
       G4cout<<"G4ClassicalRK4 (default) is called"<<G4endl;
@@ -240,6 +266,67 @@ void B1ElectricFieldSetup::CreateStepper()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void B1ElectricFieldSetup::SetParameters(const B1FieldParameters& parameters)
+{
+  G4bool changed = parameters.stepperType != fStepperType
+                   || parameters.fieldMap != fFieldMap;
+  G4bool newField = parameters.fieldMap != fFieldMap
+                    || parameters.fieldValue != fElFieldValue;
+
+  // A new stepper or minimum step needs a new driver and chord finder
+  if (parameters.stepperType != fStepperType || parameters.minStep != fMinStep)
+  {
+    fStepperType = parameters.stepperType;
+    fMinStep = parameters.minStep;
+    UpdateIntegrator();
+  }
+
+  // A new value or map replaces the field seen by the equation and the
+  // manager
+  if (newField)
+  {
+    fElFieldValue = parameters.fieldValue;
+    CreateField(parameters.fieldMap);
+  }
+  if (changed && fStepperType == 10 && !fFieldMap.empty())
+  {
+    G4ExceptionDescription msg;
+    msg << "B1UniformElectricStepper assumes a uniform field over a step,"
+        << " the field map " << fFieldMap << " is sampled at its start only";
+    G4Exception("B1ElectricFieldSetup::SetParameters()", "B1Field003",
+                JustWarning, msg);
+  }
+
+  // Accuracy of the integrated tracks and rules of the fast tracks
+  fFieldManager->SetParameters(parameters);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ElectricFieldSetup::CreateField(const G4String& fieldMap)
+{
+  G4ElectricField* oldField = fEMfield;
+
+  if (fieldMap.empty())
+  {
+    fEMfield = new G4UniformElectricField(fElFieldValue);
+  }
+  else
+  {
+    fEMfield = new B1GriddedElectricField(fieldMap, fElFieldValue);
+  }
+  fFieldMap = fieldMap;
+
+  // The old field is deleted only once nothing points to it. A zero
+  // uniform field is kept for the equation but not propagated.
+  fEquation->SetFieldObj(fEMfield);
+  G4bool zeroField = fieldMap.empty() && fElFieldValue == G4ThreeVector();
+  fFieldManager->SetGasField(zeroField ? nullptr : fEMfield);
+  delete oldField;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void B1ElectricFieldSetup::SetFieldZValue(G4double fieldValue)
 {
   // Set the value of the Global Field to fieldValue along Z
@@ -253,25 +340,17 @@ void B1ElectricFieldSetup::SetFieldZValue(G4double fieldValue)
 
 void B1ElectricFieldSetup::SetFieldValue(G4ThreeVector fieldVector)
 {
-  if (fEMfield) delete fEMfield;
-
-  // Set the value of the Global Field value to fieldVector
+  // Set the value of the Global Field value to fieldVector, or of the
+  // field outside the map
+  fElFieldValue = fieldVector;
+  CreateField(fFieldMap);
+}
 
-  // Find the Field Manager for the global field
-  G4FieldManager* fieldMgr = new G4FieldManager();
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-  if (fieldVector != G4ThreeVector(0.,0.,0.))
-  {
-    fEMfield = new G4UniformElectricField(fieldVector);
-  }
-  else
-  {
-    // If the new field's value is Zero, then it is best to
-    //  insure that it is not used for propagation.
-    fEMfield = 0;
-  }
-  fieldMgr->SetDetectorField(fEMfield);
-  fEquation->SetFieldObj(fEMfield);  // must now point to the new field
+G4FieldManager* B1ElectricFieldSetup::GetLocalFieldManager()
+{
+  return fFieldManager;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
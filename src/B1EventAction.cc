@@ -29,9 +29,14 @@
 
 #include "B1EventAction.hh"
 #include "B1RunAction.hh"
+#include "B1HitBuffer.hh"
+#include "B1RPCHit.hh"
+#include "B1GasCrossingHit.hh"
 
 #include "G4Event.hh"
 #include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4HCofThisEvent.hh"
 
 #include "G4RootAnalysisManager.hh"
 
@@ -39,25 +44,13 @@
 
 B1EventAction::B1EventAction(B1RunAction* runAction)
 : G4UserEventAction(),
-  fRunAction(runAction)
+  fRunAction(runAction),
+  fGasHitsID(-1),
+  fPlateHitsID(-1),
+  fCrossingsID(-1)
 {
-  // Pass variables over to run action
-  hitPosX = &runAction->hitPosX;
-  hitPosY = &runAction->hitPosY;
-  hitPosZ = &runAction->hitPosZ;
-  edep = &runAction->edep;
-  time = &runAction->time;
-  deltaEnergy = &runAction->deltaEnergy;
-  particleID = &runAction->particleID;
-  trackID = &runAction->trackID;
-  parentID = &runAction->parentID;
-
-  finalEnergy = &runAction->finalEnergy;
-  
-  avalancheSize = &runAction->avalancheSize;
-  avalancheEnergy = &runAction->avalancheEnergy;
-
-  layerCount = &runAction->layerCount;
+  // Hits are appended to the ntuple columns of the run action
+  fHits = &runAction->hits;
 } 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -69,48 +62,96 @@ B1EventAction::~B1EventAction()
 
 void B1EventAction::BeginOfEventAction(const G4Event*)
 {
-  // Clear all your vectors!!
-  hitPosX->clear();
-  hitPosY->clear();
-  hitPosZ->clear();
-  edep->clear();
-  time->clear();
-  deltaEnergy->clear();
-  particleID->clear();
-  trackID->clear();
-  parentID->clear();
-
-  finalEnergy->clear();
-  finalEnergy->push_back(0);
-
-  avalancheSize->clear();
-  avalancheSize->push_back(0);
-  avalancheEnergy->clear();
-
-  layerCount->clear();
-  layerCount->push_back(0);
+  fHits->Reset();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1EventAction::EndOfEventAction(const G4Event*)
+void B1EventAction::EndOfEventAction(const G4Event* event)
 {
+  // Get hits collections IDs (only once)
+  if(fGasHitsID == -1)
+    {
+      G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+      fGasHitsID = sdManager->GetCollectionID("RPCGas/Hits");
+      fPlateHitsID = sdManager->GetCollectionID("RPCPlate/Hits");
+      fCrossingsID = sdManager->GetCollectionID("RPCGas/Crossings");
+    }
+
+  G4HCofThisEvent* hce = event->GetHCofThisEvent();
+  if(hce)
+    {
+      B1RPCHitsCollection* gasHits = 0;
+      B1RPCHitsCollection* plateHits = 0;
+      B1GasCrossingHitsCollection* crossings = 0;
+      if(fGasHitsID >= 0)
+	gasHits = static_cast<B1RPCHitsCollection*>(hce->GetHC(fGasHitsID));
+      if(fPlateHitsID >= 0)
+	plateHits = static_cast<B1RPCHitsCollection*>(hce->GetHC(fPlateHitsID));
+      if(fCrossingsID >= 0)
+	crossings = static_cast<B1GasCrossingHitsCollection*>(hce->GetHC(fCrossingsID));
+
+      // Size the columns once for the whole event
+      size_t nGasHits = gasHits ? gasHits->entries() : 0;
+      size_t nPlateHits = plateHits ? plateHits->entries() : 0;
+      size_t nCrossings = crossings ? crossings->entries() : 0;
+      fHits->Reserve(nGasHits, nPlateHits, nCrossings);
+
+      // Gas and plate hits go to their own streams, the collections are
+      // empty if the hits are not written out
+      if(gasHits)
+	AppendHits(gasHits, fHits->gas);
+      if(plateHits)
+	AppendHits(plateHits, fHits->plate);
+
+      // Layers crossed by the primary, avalanche electrons and the clusters
+      // of the fast simulation
+      for(size_t i=0; i<nCrossings; i++)
+	{
+	  const B1GasCrossingHit* crossing = (*crossings)[i];
+	  if(crossing->GetParentID() == 0)
+	    fHits->CountLayer();
+	  if(crossing->IsAvalanche())
+	    fHits->AppendAvalanche(crossing->GetPrimaryID(), crossing->GetVertexEnergy());
+	  if(crossing->GetClusterSize() > 0)
+	    fHits->AppendCluster(crossing->GetPrimaryID(), crossing->GetClusterSize());
+	}
+    }
+
+  // Weight of the biased primaries
+  const G4PrimaryVertex* vertex = event->GetPrimaryVertex(0);
+  if(vertex)
+    fHits->SetWeight(vertex->GetWeight());
+
   auto *analysisManager = G4RootAnalysisManager::Instance();
   analysisManager->AddNtupleRow();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1EventAction::HitPos(G4double x, G4double y, G4double z)
+void B1EventAction::FinalEnergy(G4double value)
 {
-  hitPosX->push_back(x);
-  hitPosY->push_back(y);
-  hitPosZ->push_back(z);
+  fHits->SetFinalEnergy(value);
 }
 
-void B1EventAction::IDNumbers(G4int pID, G4int tID, G4int prntID)
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::AppendHits(const B1RPCHitsCollection* hits,
+			       B1HitBuffer::Stream& stream)
 {
-  particleID->push_back(pID);
-  trackID->push_back(tID);
-  parentID->push_back(prntID);
+  G4bool aggregate = fRunAction->aggregateHits;
+  G4bool positions = fRunAction->GetOutputPositions();
+  for(size_t i=0; i<hits->entries(); i++)
+    {
+      const B1RPCHit* hit = (*hits)[i];
+      B1HitBuffer::AppendHit(stream, hit->GetParticleID(), hit->GetTrackID(),
+			     hit->GetParentID(), hit->GetPrimaryID(),
+			     hit->GetChannelID(), hit->GetTime(), hit->GetEnergy());
+      if(positions)
+	B1HitBuffer::AppendHitPos(stream, hit->GetPos());
+      if(aggregate)
+	B1HitBuffer::AppendHitEntry(stream, hit->GetEntryPos(), hit->GetNofSteps());
+    }
 }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,498 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventFile.cc
+/// \brief Implementation of the B1EventFile class
+
+#include "B1EventFile.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  const char kMagic[8] = { 'B', '1', 'E', 'V', 'T', 'S', '0', '1' };
+  static_assert(sizeof(B1EventFile::Header) == 24, "event file header must be 24 bytes");
+  static_assert(sizeof(B1EventFile::Particle) == 64, "particle record must be 64 bytes");
+
+  const double kSpeedOfLight = 299.792458;   // mm/ns
+
+  // Tokens of a HepMC3 line, bounded by the end of the line since the
+  // mapping is not null terminated
+  class LineReader
+  {
+    public:
+      LineReader(const char* begin, const char* end) : fPos(begin), fEnd(end) {}
+
+      // Next token, false at the end of the line
+      void SkipSpaces()
+      {
+	while(fPos < fEnd && (*fPos == ' ' || *fPos == '\t' || *fPos == '\r'))
+	  fPos++;
+      }
+
+      bool Token(char* buffer, size_t size)
+      {
+	SkipSpaces();
+	size_t n = 0;
+	while(fPos < fEnd && *fPos != ' ' && *fPos != '\t' && *fPos != '\r')
+	  {
+	    if(n + 1 < size)
+	      buffer[n++] = *fPos;
+	    fPos++;
+	  }
+	buffer[n] = '\0';
+	return n > 0;
+      }
+
+      // Decimal numbers of at most 15 digits and power of ten of at most
+      // 22 are converted exactly with one multiplication or division (the
+      // HepMC3 writer uses 8 decimals), the others with strtod
+      bool Double(double& value)
+      {
+	static const double kPowers[23] =
+	  { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	SkipSpaces();
+	const char* begin = fPos;
+	const char* p = fPos;
+	bool negative = (p < fEnd && (*p == '-' || *p == '+')) ? (*p++ == '-') : false;
+	uint64_t mantissa = 0;
+	int nDigits = 0, exponent = 0;
+	bool digits = false;
+	for(; p < fEnd && *p >= '0' && *p <= '9'; p++, digits = true)
+	  if(mantissa || *p != '0')
+	    {
+	      mantissa = 10*mantissa + (*p - '0');
+	      nDigits++;
+	    }
+	if(p < fEnd && *p == '.')
+	  {
+	    for(p++; p < fEnd && *p >= '0' && *p <= '9'; p++, digits = true)
+	      {
+		if(mantissa || *p != '0')
+		  {
+		    mantissa = 10*mantissa + (*p - '0');
+		    nDigits++;
+		  }
+		exponent--;
+	      }
+	  }
+	if(digits && p < fEnd && (*p == 'e' || *p == 'E'))
+	  {
+	    const char* q = p + 1;
+	    bool negativeExponent = (q < fEnd && (*q == '-' || *q == '+')) ? (*q++ == '-') : false;
+	    int e = 0;
+	    bool exponentDigits = false;
+	    for(; q < fEnd && *q >= '0' && *q <= '9' && e < 10000; q++, exponentDigits = true)
+	      e = 10*e + (*q - '0');
+	    if(exponentDigits)
+	      {
+		exponent += negativeExponent ? -e : e;
+		p = q;
+	      }
+	  }
+	bool end = (p == fEnd || *p == ' ' || *p == '\t' || *p == '\r');
+	if(digits && end && nDigits <= 15 && exponent >= -22 && exponent <= 22)
+	  {
+	    value = (exponent < 0) ? double(mantissa)/kPowers[-exponent]
+	      : double(mantissa)*kPowers[exponent];
+	    if(negative)
+	      value = -value;
+	    fPos = p;
+	    return true;
+	  }
+
+	// Slow path, from the start of the token
+	fPos = begin;
+	char buffer[64];
+	char* last;
+	if(!Token(buffer, sizeof(buffer)))
+	  return false;
+	value = std::strtod(buffer, &last);
+	return *last == '\0';
+      }
+
+      bool Long(long& value)
+      {
+	SkipSpaces();
+	const char* p = fPos;
+	bool negative = (p < fEnd && (*p == '-' || *p == '+')) ? (*p++ == '-') : false;
+	const char* digits = p;
+	long result = 0;
+	for(; p < fEnd && *p >= '0' && *p <= '9'; p++)
+	  result = 10*result + (*p - '0');
+	if(p == digits || p - digits > 18 || !(p == fEnd || *p == ' ' || *p == '\t' || *p == '\r'))
+	  return false;
+	value = negative ? -result : result;
+	fPos = p;
+	return true;
+      }
+
+      // Position after an "@" token, if any
+      bool Position(double position[4])
+      {
+	char buffer[64];
+	while(Token(buffer, sizeof(buffer)))
+	  if(std::strcmp(buffer, "@") == 0)
+	    return Double(position[0]) && Double(position[1])
+	      && Double(position[2]) && Double(position[3]);
+	return false;
+      }
+
+      // First entry of a vertex parent list "[p1,p2,...]"
+      bool FirstParent(long& parent)
+      {
+	char buffer[1024];
+	if(!Token(buffer, sizeof(buffer)) || buffer[0] != '[')
+	  return false;
+	parent = std::strtol(buffer + 1, nullptr, 10);
+	return parent > 0;
+      }
+
+    private:
+      const char* fPos;
+      const char* fEnd;
+  };
+
+  struct Position
+  {
+    double value[4];
+    bool set;
+  };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventFile::B1EventFile()
+  : fMapping(nullptr),
+    fSize(0),
+    fData(nullptr),
+    fHepMC(false),
+    fCursor(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventFile::~B1EventFile()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool B1EventFile::Open(const std::string& fileName, std::string& error)
+{
+  Close();
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd < 0)
+    {
+      error = "cannot open " + fileName;
+      return false;
+    }
+  struct stat status;
+  if(fstat(fd, &status) != 0 || status.st_size == 0)
+    {
+      close(fd);
+      error = fileName + " is empty";
+      return false;
+    }
+  fSize = status.st_size;
+  fMapping = mmap(nullptr, fSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(fMapping == MAP_FAILED)
+    {
+      fMapping = nullptr;
+      error = "cannot map " + fileName;
+      return false;
+    }
+  fData = static_cast<const char*>(fMapping);
+
+  // Events are read in order, several ranges at a time
+  madvise(fMapping, fSize, MADV_SEQUENTIAL);
+
+  fHepMC = !(fSize >= sizeof(Header) && std::memcmp(fData, kMagic, sizeof(kMagic)) == 0);
+  bool indexed = fHepMC ? IndexHepMC(error) : IndexBinary(error);
+  if(!indexed)
+    {
+      Close();
+      error = fileName + ": " + error;
+      return false;
+    }
+  fCursor = 0;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventFile::Close()
+{
+  if(fMapping)
+    munmap(fMapping, fSize);
+  fMapping = nullptr;
+  fSize = 0;
+  fData = nullptr;
+  fOffsets.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool B1EventFile::IndexBinary(std::string& error)
+{
+  Header header;
+  std::memcpy(&header, fData, sizeof(header));
+  if(header.indexOffset < sizeof(Header) || header.indexOffset > fSize
+     || (fSize - header.indexOffset)/sizeof(uint64_t) != header.nEvents + 1)
+    {
+      error = "bad event index";
+      return false;
+    }
+
+  fOffsets.resize(header.nEvents + 1);
+  std::memcpy(fOffsets.data(), fData + header.indexOffset,
+	      fOffsets.size()*sizeof(uint64_t));
+  for(size_t i=0; i<header.nEvents; i++)
+    if(fOffsets[i] < sizeof(Header) || fOffsets[i + 1] > header.indexOffset
+       || fOffsets[i + 1] < fOffsets[i] + sizeof(EventHeader))
+      {
+	error = "bad event offsets";
+	return false;
+      }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool B1EventFile::IndexHepMC(std::string& error)
+{
+  // Events start with an "E" line and end at the next one, or at the end
+  // of the listing
+  const char* end = fData + fSize;
+  const char* line = fData;
+  while(line < end)
+    {
+      const char* next = static_cast<const char*>(std::memchr(line, '\n', end - line));
+      next = next ? next + 1 : end;
+      if(line[0] == 'E' && next - line > 1 && (line[1] == ' ' || line[1] == '\t'))
+	fOffsets.push_back(line - fData);
+      else if(!fOffsets.empty() && next - line >= 7 && std::memcmp(line, "HepMC::", 7) == 0)
+	break;
+      line = next;
+    }
+
+  if(fOffsets.empty())
+    {
+      error = "neither a B1EventFile nor a HepMC3 ASCII event file";
+      return false;
+    }
+  fOffsets.push_back(line < end ? line - fData : fSize);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool B1EventFile::Read(size_t event, std::vector<Particle>& particles, uint32_t& number) const
+{
+  particles.clear();
+  if(event >= NofEvents())
+    return false;
+  if(fHepMC)
+    return ReadHepMC(event, particles, number);
+
+  EventHeader header;
+  const char* data = fData + fOffsets[event];
+  std::memcpy(&header, data, sizeof(header));
+  if(fOffsets[event + 1] - fOffsets[event]
+     != sizeof(EventHeader) + header.nParticles*sizeof(Particle))
+    return false;
+  number = header.number;
+  particles.resize(header.nParticles);
+  std::memcpy(particles.data(), data + sizeof(EventHeader),
+	      header.nParticles*sizeof(Particle));
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool B1EventFile::ReadHepMC(size_t event, std::vector<Particle>& particles,
+			    uint32_t& number) const
+{
+  const char* line = fData + fOffsets[event];
+  const char* end = fData + fOffsets[event + 1];
+
+  double momentumUnit = 1000.;   // GEV
+  double lengthUnit = 1.;        // MM
+  double eventPosition[4] = { 0., 0., 0., 0. };
+
+  // Production positions of the particles and of the explicit vertices,
+  // by id. A particle made at the end vertex of its mother (positive
+  // production id) or at a vertex without position inherits the
+  // position of the mother
+  std::vector<Position> particlePositions(1, Position());
+  std::vector<Position> vertexPositions(1, Position());
+  char tag[16];
+
+  while(line < end)
+    {
+      const char* next = static_cast<const char*>(std::memchr(line, '\n', end - line));
+      const char* lineEnd = next ? next : end;
+      LineReader reader(line, lineEnd);
+      line = next ? next + 1 : end;
+      if(!reader.Token(tag, sizeof(tag)) || tag[1] != '\0')
+	continue;
+
+      if(tag[0] == 'E')
+	{
+	  long value;
+	  if(!reader.Long(value))
+	    return false;
+	  number = uint32_t(value);
+	  if(!reader.Position(eventPosition))
+	    eventPosition[0] = eventPosition[1] = eventPosition[2] = eventPosition[3] = 0.;
+	  particlePositions[0].set = vertexPositions[0].set = true;
+	  std::copy(eventPosition, eventPosition + 4, particlePositions[0].value);
+	  std::copy(eventPosition, eventPosition + 4, vertexPositions[0].value);
+	}
+      else if(tag[0] == 'U')
+	{
+	  char unit[16];
+	  if(!reader.Token(unit, sizeof(unit)))
+	    return false;
+	  momentumUnit = (std::strcmp(unit, "MEV") == 0) ? 1. : 1000.;
+	  if(!reader.Token(unit, sizeof(unit)))
+	    return false;
+	  lengthUnit = (std::strcmp(unit, "CM") == 0) ? 10. : 1.;
+
+	  // The event position comes before the units
+	  for(int i=0; i<4; i++)
+	    vertexPositions[0].value[i] = particlePositions[0].value[i]
+	      = eventPosition[i]*lengthUnit;
+	}
+      else if(tag[0] == 'V')
+	{
+	  long id, status, parent = 0;
+	  if(!reader.Long(id) || id >= 0 || !reader.Long(status))
+	    return false;
+	  if(size_t(-id) >= vertexPositions.size())
+	    vertexPositions.resize(-id + 1, Position());
+	  Position& position = vertexPositions[-id];
+	  bool hasParent = reader.FirstParent(parent);
+	  if(reader.Position(position.value))
+	    {
+	      for(int i=0; i<4; i++)
+		position.value[i] *= lengthUnit;
+	      position.set = true;
+	    }
+	  else if(hasParent && size_t(parent) < particlePositions.size())
+	    position = particlePositions[parent];
+	  else
+	    position = vertexPositions[0];
+	}
+      else if(tag[0] == 'P')
+	{
+	  long id, production, pdg, status;
+	  double p[5];
+	  if(!reader.Long(id) || id <= 0 || !reader.Long(production) || !reader.Long(pdg)
+	     || !reader.Double(p[0]) || !reader.Double(p[1]) || !reader.Double(p[2])
+	     || !reader.Double(p[3]) || !reader.Double(p[4]) || !reader.Long(status))
+	    return false;
+
+	  const Position* origin = &vertexPositions[0];
+	  if(production < 0 && size_t(-production) < vertexPositions.size()
+	     && vertexPositions[-production].set)
+	    origin = &vertexPositions[-production];
+	  else if(production > 0 && size_t(production) < particlePositions.size())
+	    origin = &particlePositions[production];
+	  if(size_t(id) >= particlePositions.size())
+	    particlePositions.resize(id + 1, Position());
+	  particlePositions[id] = *origin;
+
+	  if(status != 1)
+	    continue;
+	  Particle particle;
+	  particle.pdg = int32_t(pdg);
+	  particle.reserved = 0;
+	  for(int i=0; i<3; i++)
+	    {
+	      particle.momentum[i] = p[i]*momentumUnit;
+	      particle.position[i] = origin->value[i];
+	    }
+	  particle.position[3] = origin->value[3]/kSpeedOfLight;
+	  particles.push_back(particle);
+	}
+    }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+size_t B1EventFile::Claim(size_t nEvents, size_t& begin)
+{
+  size_t total = NofEvents();
+  begin = fCursor.fetch_add(nEvents, std::memory_order_relaxed);
+  if(begin >= total)
+    return 0;
+  return std::min(nEvents, total - begin);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool B1EventFile::Write(const std::string& fileName, const std::vector<uint32_t>& numbers,
+			const std::vector<size_t>& offsets,
+			const std::vector<Particle>& particles)
+{
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.nEvents = numbers.size();
+  header.indexOffset = sizeof(Header) + numbers.size()*sizeof(EventHeader)
+    + particles.size()*sizeof(Particle);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  std::vector<uint64_t> index(1, sizeof(Header));
+  for(size_t i=0; i<numbers.size(); i++)
+    {
+      EventHeader event;
+      event.number = numbers[i];
+      event.nParticles = offsets[i + 1] - offsets[i];
+      file.write(reinterpret_cast<const char*>(&event), sizeof(event));
+      file.write(reinterpret_cast<const char*>(particles.data() + offsets[i]),
+		 event.nParticles*sizeof(Particle));
+      index.push_back(index.back() + sizeof(EventHeader) + event.nParticles*sizeof(Particle));
+    }
+  file.write(reinterpret_cast<const char*>(index.data()), index.size()*sizeof(uint64_t));
+  return bool(file);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,163 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventFileGenerator.cc
+/// \brief Implementation of the B1EventFileGenerator class
+
+#include "B1EventFileGenerator.hh"
+
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4ParticleTable.hh"
+#include "G4RunManager.hh"
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace
+{
+  // Files of the process, opened by the first thread asking for them
+  G4Mutex filesMutex = G4MUTEX_INITIALIZER;
+  std::map<G4String, std::unique_ptr<B1EventFile> > files;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventFileGenerator::B1EventFileGenerator()
+  : G4VPrimaryGenerator(),
+    fFile(nullptr),
+    fChunk(64),
+    fNext(0),
+    fEnd(0),
+    fNofSkipped(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventFileGenerator::~B1EventFileGenerator()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventFileGenerator::SetFile(const G4String& fileName)
+{
+  fFile = nullptr;
+  fNext = fEnd = 0;
+  if(fileName.empty())
+    return;
+
+  G4AutoLock lock(&filesMutex);
+  std::unique_ptr<B1EventFile>& file = files[fileName];
+  if(!file)
+    {
+      file.reset(new B1EventFile());
+      std::string error;
+      if(!file->Open(fileName, error))
+	{
+	  file.reset();
+	  G4ExceptionDescription msg;
+	  msg << "Event file not loaded: " << error;
+	  G4Exception("B1EventFileGenerator::SetFile()", "B1Input001",
+		      JustWarning, msg);
+	  return;
+	}
+      G4cout << " B1EventFileGenerator: " << fileName << ", "
+	     << file->NofEvents() << (file->IsHepMC() ? " HepMC3 ASCII" : " binary")
+	     << " events" << G4endl;
+    }
+  fFile = file.get();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventFileGenerator::GeneratePrimaryVertex(G4Event* event)
+{
+  if(!fFile)
+    return;
+
+  // Next event of the range of this thread, or a new range
+  uint32_t number = 0;
+  G4bool read = false;
+  while(!read)
+    {
+      if(fNext == fEnd)
+	{
+	  size_t begin;
+	  size_t n = fFile->Claim(fChunk, begin);
+	  if(n == 0)
+	    {
+	      G4Exception("B1EventFileGenerator::GeneratePrimaryVertex()", "B1Input002",
+			  JustWarning, "End of the event file, the run is aborted");
+	      G4RunManager::GetRunManager()->AbortRun(true);
+	      return;
+	    }
+	  fNext = begin;
+	  fEnd = begin + n;
+	}
+      read = fFile->Read(fNext, fParticles, number);
+      if(!read)
+	{
+	  G4ExceptionDescription msg;
+	  msg << "Event " << fNext << " of the event file cannot be parsed, skipped";
+	  G4Exception("B1EventFileGenerator::GeneratePrimaryVertex()", "B1Input003",
+		      JustWarning, msg);
+	}
+      fNext++;
+    }
+
+  // One vertex per position, the particles of a vertex being consecutive
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+  G4PrimaryVertex* vertex = nullptr;
+  const G4double* lastPosition = nullptr;
+  for(const B1EventFile::Particle& particle : fParticles)
+    {
+      G4ParticleDefinition* definition = particleTable->FindParticle(particle.pdg);
+      if(!definition)
+	{
+	  // Reported for the first ones only
+	  if(fNofSkipped++ < 10)
+	    G4cout << " B1EventFileGenerator: unknown PDG code " << particle.pdg
+		   << " in event " << number << ", particle skipped" << G4endl;
+	  continue;
+	}
+
+      const G4double* position = particle.position;
+      if(!lastPosition || !std::equal(position, position + 4, lastPosition))
+	{
+	  vertex = new G4PrimaryVertex(position[0], position[1], position[2], position[3]);
+	  event->AddPrimaryVertex(vertex);
+	  lastPosition = position;
+	}
+      vertex->SetPrimary(new G4PrimaryParticle(definition, particle.momentum[0],
+					       particle.momentum[1], particle.momentum[2]));
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,315 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1FieldBenchmark.cc
+/// \brief Implementation of the B1FieldBenchmark class
+
+#include "B1FieldBenchmark.hh"
+#include "B1DetectorConstruction.hh"
+
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4Navigator.hh"
+#include "G4GeometryManager.hh"
+#include "G4PropagatorInField.hh"
+#include "G4FieldManager.hh"
+#include "G4ChordFinder.hh"
+#include "G4MagIntegratorDriver.hh"
+#include "G4EquationOfMotion.hh"
+#include "G4FieldTrack.hh"
+#include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Electron.hh"
+#include "G4ChargeState.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Timer.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+  // Longest step proposed to the propagator and steps per electron
+  const G4double kProposedStep = 10*mm;
+  const G4int kMaxSteps = 1000;
+
+  // Settings of a row of the table
+  struct FieldConfiguration
+  {
+    const char* name;
+    B1FieldParameters parameters;
+  };
+
+  // Stepper and accuracy of a row, the defaults or tight ones
+  B1FieldParameters Settings(G4int stepperType, G4bool tight)
+  {
+    B1FieldParameters parameters;
+    parameters.stepperType = stepperType;
+    if(tight)
+      {
+	parameters.deltaChord = 0.01*mm;
+	parameters.deltaOneStep = 0.1*um;
+	parameters.deltaIntersection = 0.01*um;
+	parameters.epsilonMin = 1e-7;
+	parameters.epsilonMax = 1e-6;
+      }
+    return parameters;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1FieldBenchmark::B1FieldBenchmark(B1DetectorConstruction* detector,
+				   G4VPhysicalVolume* world, G4LogicalVolume* logicGas)
+  : fDetector(detector),
+    fWorld(world),
+    fLogicGas(logicGas),
+    fLayout(detector->GetLayout()),
+    fParameters(detector->GetFieldParameters())
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1FieldBenchmark::~B1FieldBenchmark()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1FieldBenchmark::Run(G4int nEvents, G4int nElectrons)
+{
+  // The reference, the exact stepper at tight accuracy, comes first
+  const FieldConfiguration configurations[] = {
+    { "Exact, tight",          Settings(10, true) },
+    { "Exact",                 Settings(10, false) },
+    { "ClassicalRK4",          Settings(4, false) },
+    { "ClassicalRK4, tight",   Settings(4, true) },
+    { "CashKarpRKF45",         Settings(5, false) },
+    { "CashKarpRKF45, tight",  Settings(5, true) },
+    { "DormandPrince745",      Settings(11, false) },
+    { "DormandPrince745, tight", Settings(11, true) }
+  };
+
+  SampleElectrons(nElectrons);
+  std::vector<G4ThreeVector> reference, endPoints;
+  std::vector<G4bool> referenceInGas, inGas;
+
+  std::ostringstream table;
+  table << std::setw(26) << std::left << " Configuration" << std::right
+	<< std::setw(12) << "events/s" << std::setw(14) << "electrons/s"
+	<< std::setw(16) << "mean error/um" << std::setw(15) << "max error/um";
+  G4int nSkipped = 0;
+
+  for(const FieldConfiguration& configuration : configurations)
+    {
+      // Only the stepper and the accuracy change from the given settings
+      B1FieldParameters parameters = fParameters;
+      parameters.stepperType = configuration.parameters.stepperType;
+      parameters.deltaChord = configuration.parameters.deltaChord;
+      parameters.deltaOneStep = configuration.parameters.deltaOneStep;
+      parameters.deltaIntersection = configuration.parameters.deltaIntersection;
+      parameters.epsilonMin = configuration.parameters.epsilonMin;
+      parameters.epsilonMax = configuration.parameters.epsilonMax;
+      Apply(parameters);
+
+      G4double eventTime = RunEvents(nEvents);
+      G4double electronTime;
+      G4double sumError = 0., maxError = 0.;
+      G4int nCompared = 0;
+      if(reference.empty())
+	{
+	  electronTime = PropagateElectrons(reference, referenceInGas);
+	  for(G4bool in : referenceInGas)
+	    if(!in)
+	      nSkipped++;
+	}
+      else
+	{
+	  electronTime = PropagateElectrons(endPoints, inGas);
+	  for(size_t i=0; i<endPoints.size(); i++)
+	    if(inGas[i] && referenceInGas[i])
+	      {
+		G4double error = (endPoints[i] - reference[i]).mag();
+		sumError += error;
+		maxError = std::max(maxError, error);
+		nCompared++;
+	      }
+	}
+
+      table << G4endl << " " << std::setw(25) << std::left << configuration.name << std::right
+	    << std::setw(12) << (eventTime > 0. ? nEvents/eventTime : 0.)
+	    << std::setw(14) << (electronTime > 0. ? nElectrons/electronTime : 0.)
+	    << std::setw(16) << (nCompared ? sumError/nCompared/um : 0.)
+	    << std::setw(15) << maxError/um;
+    }
+
+  Apply(fParameters);
+
+  G4cout
+     << G4endl
+     << "--------------------Field benchmark-------------------------"
+     << G4endl
+     << " " << nEvents << " events and " << nElectrons - nSkipped
+     << " gas electrons per configuration, endpoint errors against the first"
+     << G4endl
+     << table.str()
+     << G4endl
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1FieldBenchmark::SampleElectrons(G4int nElectrons)
+{
+  // Avalanche-like electrons at random points of the gas layers
+  std::vector<B1RPCLayout::Slab> slabs = fLayout.GasSlabs();
+  fStarts.resize(nElectrons);
+  fDirections.resize(nElectrons);
+  fEnergies.resize(nElectrons);
+  const G4double minEnergy = 10*eV, maxEnergy = 5*keV;
+  for(G4int i=0; i<nElectrons; i++)
+    {
+      const B1RPCLayout::Slab& slab = slabs[G4int(slabs.size()*G4UniformRand())];
+      G4double point[3];
+      for(G4int axis=0; axis<3; axis++)
+	point[axis] = slab.min[axis] + (slab.max[axis] - slab.min[axis])*G4UniformRand();
+      fStarts[i] = G4ThreeVector(point[0], point[1], point[2]);
+      fDirections[i] = G4RandomDirection();
+      fEnergies[i] = minEnergy*std::pow(maxEnergy/minEnergy, G4UniformRand());
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1FieldBenchmark::Apply(const B1FieldParameters& parameters)
+{
+  // Fields of the threads at the next run, and field of the electrons
+  fDetector->SetFieldParameters(parameters);
+  fSetup.SetParameters(parameters);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1FieldBenchmark::RunEvents(G4int nEvents) const
+{
+  if(nEvents <= 0)
+    return 0.;
+
+  G4UImanager::GetUIpointer()->ApplyCommand("/random/setSeeds 12345 67890");
+  G4Timer timer;
+  timer.Start();
+  G4RunManager::GetRunManager()->BeamOn(nEvents);
+  timer.Stop();
+  return timer.GetRealElapsed();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1FieldBenchmark::PropagateElectrons(std::vector<G4ThreeVector>& endPoints,
+					      std::vector<G4bool>& inGas)
+{
+  // Voxelise as for tracking, nothing is done if the geometry is closed
+  G4GeometryManager::GetInstance()->CloseGeometry(true);
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(fWorld);
+  // Field manager of the benchmark, whatever the thread: without a volume
+  // the propagator takes it in place of that of the gas volume, if any
+  G4FieldManager* fieldManager = fSetup.GetLocalFieldManager();
+  G4PropagatorInField propagator(&navigator, fieldManager);
+  G4ChargeState chargeState(-eplus, 0., 0.5);
+
+  // Track given to the field manager, as by the transportation
+  G4Track electron(new G4DynamicParticle(G4Electron::Definition(), G4ThreeVector(0, 0, 1), 0.),
+		   0., G4ThreeVector());
+
+  size_t nElectrons = fStarts.size();
+  endPoints.resize(nElectrons);
+  inGas.assign(nElectrons, false);
+
+  G4Timer timer;
+  timer.Start();
+
+  for(size_t i=0; i<nElectrons; i++)
+    {
+      G4ThreeVector pos = fStarts[i];
+      G4ThreeVector dir = fDirections[i];
+      endPoints[i] = pos;
+      G4VPhysicalVolume* volume
+	= navigator.LocateGlobalPointAndSetup(pos, &dir, false, false);
+      if(!volume || volume->GetLogicalVolume() != fLogicGas)
+	continue;
+      inGas[i] = true;
+
+      G4FieldTrack track(pos, 0., dir, fEnergies[i], electron_mass_c2, -eplus,
+			 G4ThreeVector());
+      electron.SetPosition(pos);
+      electron.SetMomentumDirection(dir);
+      electron.SetKineticEnergy(fEnergies[i]);
+      for(G4int step=0; step<kMaxSteps; step++)
+	{
+	  // Propagation mode, charge and mass of the electron in the equation
+	  // of the gas field, as set by the transportation
+	  propagator.FindAndSetFieldManager(nullptr);
+	  electron.SetKineticEnergy(track.GetKineticEnergy());
+	  fieldManager->ConfigureForTrack(&electron);
+	  G4EquationOfMotion* equation = fieldManager->GetChordFinder()
+	    ->GetIntegrationDriver()->GetEquationOfMotion();
+	  equation->SetChargeMomentumMass(chargeState, track.GetMomentum().mag(),
+					  electron_mass_c2);
+
+	  G4double safety;
+	  G4double length = propagator.ComputeStep(track, kProposedStep, safety, nullptr);
+	  pos = track.GetPosition();
+	  dir = track.GetMomentumDir();
+	  if(propagator.IsParticleLooping())
+	    break;
+
+	  if(length < kProposedStep)
+	    {
+	      // Boundary, stop when the electron leaves the gas
+	      navigator.SetGeometricallyLimitedStep();
+	      volume = navigator.LocateGlobalPointAndSetup(pos, &dir, true);
+	      if(!volume || volume->GetLogicalVolume() != fLogicGas)
+		break;
+	    }
+	  else
+	    navigator.LocateGlobalPointWithinVolume(pos);
+	}
+      endPoints[i] = pos;
+    }
+
+  timer.Stop();
+  return timer.GetRealElapsed();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,215 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1FieldMap.cc
+/// \brief Implementation of the B1FieldMap class
+
+#include "B1FieldMap.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  const char kMagic[8] = { 'B', '1', 'E', 'M', 'A', 'P', '0', '1' };
+  static_assert(sizeof(B1FieldMap::Header) == 80, "field map header must be 80 bytes");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1FieldMap::B1FieldMap()
+  : fMapping(nullptr),
+    fMappingSize(0),
+    fHeader(nullptr),
+    fValues(nullptr)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1FieldMap::~B1FieldMap()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool B1FieldMap::Open(const std::string& fileName, std::string& error)
+{
+  Close();
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd < 0)
+    {
+      error = "cannot open " + fileName;
+      return false;
+    }
+  struct stat status;
+  if(fstat(fd, &status) != 0 || size_t(status.st_size) < sizeof(Header))
+    {
+      close(fd);
+      error = fileName + " is too short for a field map";
+      return false;
+    }
+  fMappingSize = status.st_size;
+  fMapping = mmap(nullptr, fMappingSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(fMapping == MAP_FAILED)
+    {
+      fMapping = nullptr;
+      error = "cannot map " + fileName;
+      return false;
+    }
+
+  // Check the header and the size of the grid
+  const Header* header = static_cast<const Header*>(fMapping);
+  size_t nNodes = 1;
+  bool valid = std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0;
+  for(int i=0; valid && i<3; i++)
+    {
+      valid = header->nodes[i] >= 2 && header->max[i] > header->min[i];
+      nNodes *= header->nodes[i];
+    }
+  if(!valid || fMappingSize != sizeof(Header) + 4*sizeof(float)*nNodes)
+    {
+      Close();
+      error = fileName + " is not a valid field map";
+      return false;
+    }
+
+  fHeader = header;
+  fValues = reinterpret_cast<const float*>(header + 1);
+  for(int i=0; i<3; i++)
+    {
+      fMin[i] = header->min[i];
+      fNodes[i] = header->nodes[i];
+      fInvStep[i] = (fNodes[i] - 1)/(header->max[i] - header->min[i]);
+    }
+  fStride[0] = 1;
+  fStride[1] = fNodes[0];
+  fStride[2] = fNodes[0]*fNodes[1];
+
+  // The queries follow the tracks, not the file order
+  madvise(fMapping, fMappingSize, MADV_RANDOM);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1FieldMap::Close()
+{
+  if(fMapping)
+    munmap(fMapping, fMappingSize);
+  fMapping = nullptr;
+  fMappingSize = 0;
+  fHeader = nullptr;
+  fValues = nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool B1FieldMap::Evaluate(const double position[3], double field[3], Cache& cache) const
+{
+  // Cell and position in the cell, the last cell along an axis is closed
+  long index[3];
+  float fraction[3];
+  for(int i=0; i<3; i++)
+    {
+      double t = (position[i] - fMin[i])*fInvStep[i];
+      if(!(t >= 0. && t <= fNodes[i] - 1))
+	return false;
+      long node = std::min(long(t), fNodes[i] - 2);
+      index[i] = node;
+      fraction[i] = float(t - node);
+    }
+  long cell = index[0] + index[1]*fStride[1] + index[2]*fStride[2];
+
+  if(cell != cache.cell)
+    {
+      for(int corner=0; corner<8; corner++)
+	{
+	  long node = cell + (corner & 1)*fStride[0]
+	    + ((corner >> 1) & 1)*fStride[1] + ((corner >> 2) & 1)*fStride[2];
+	  std::memcpy(cache.corners[corner], fValues + 4*node, 4*sizeof(float));
+	}
+      cache.cell = cell;
+    }
+
+  // Blend along x, then y, then z, four components at a time
+  const float (*c)[4] = cache.corners;
+  float fx = fraction[0], fy = fraction[1], fz = fraction[2];
+  float x00[4], x10[4], x01[4], x11[4], y0[4], y1[4], value[4];
+  for(int k=0; k<4; k++)
+    {
+      x00[k] = c[0][k] + fx*(c[1][k] - c[0][k]);
+      x10[k] = c[2][k] + fx*(c[3][k] - c[2][k]);
+      x01[k] = c[4][k] + fx*(c[5][k] - c[4][k]);
+      x11[k] = c[6][k] + fx*(c[7][k] - c[6][k]);
+    }
+  for(int k=0; k<4; k++)
+    {
+      y0[k] = x00[k] + fy*(x10[k] - x00[k]);
+      y1[k] = x01[k] + fy*(x11[k] - x01[k]);
+    }
+  for(int k=0; k<4; k++)
+    value[k] = y0[k] + fz*(y1[k] - y0[k]);
+
+  field[0] = value[0];
+  field[1] = value[1];
+  field[2] = value[2];
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool B1FieldMap::Write(const std::string& fileName, const uint32_t nodes[3],
+		       const double min[3], const double max[3], const float* values)
+{
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  size_t nNodes = 1;
+  for(int i=0; i<3; i++)
+    {
+      header.nodes[i] = nodes[i];
+      header.min[i] = min[i];
+      header.max[i] = max[i];
+      nNodes *= nodes[i];
+    }
+
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(values), 4*sizeof(float)*nNodes);
+  return bool(file);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,103 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1GasCrossingHit.cc
+/// \brief Implementation of the B1GasCrossingHit class
+
+#include "B1GasCrossingHit.hh"
+
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <iomanip>
+
+G4ThreadLocal G4Allocator<B1GasCrossingHit>* B1GasCrossingHitAllocator = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GasCrossingHit::B1GasCrossingHit()
+ : G4VHit(),
+   fTrackID(-1),
+   fParentID(-1),
+   fPrimaryID(-1),
+   fVertexEnergy(0.),
+   fAvalanche(false),
+   fClusterSize(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GasCrossingHit::~B1GasCrossingHit() {}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GasCrossingHit::B1GasCrossingHit(const B1GasCrossingHit& right)
+  : G4VHit()
+{
+  fTrackID      = right.fTrackID;
+  fParentID     = right.fParentID;
+  fPrimaryID    = right.fPrimaryID;
+  fVertexEnergy = right.fVertexEnergy;
+  fAvalanche    = right.fAvalanche;
+  fClusterSize  = right.fClusterSize;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const B1GasCrossingHit& B1GasCrossingHit::operator=(const B1GasCrossingHit& right)
+{
+  fTrackID      = right.fTrackID;
+  fParentID     = right.fParentID;
+  fPrimaryID    = right.fPrimaryID;
+  fVertexEnergy = right.fVertexEnergy;
+  fAvalanche    = right.fAvalanche;
+  fClusterSize  = right.fClusterSize;
+
+  return *this;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1GasCrossingHit::operator==(const B1GasCrossingHit& right) const
+{
+  return ( this == &right ) ? 1 : 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GasCrossingHit::Print()
+{
+  G4cout
+     << "  trackID: " << fTrackID << " parentID: " << fParentID
+     << " vertex energy: "
+     << std::setw(7) << G4BestUnit(fVertexEnergy,"Energy")
+     << (fAvalanche ? " (avalanche electron)" : "");
+  if(fClusterSize > 0)
+    G4cout << " cluster of " << fClusterSize << " electrons";
+  G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
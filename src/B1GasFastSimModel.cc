@@ -0,0 +1,155 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1GasFastSimModel.cc
+/// \brief Implementation of the B1GasFastSimModel class
+
+#include "B1GasFastSimModel.hh"
+#include "B1RPCSensitiveDetector.hh"
+
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Track.hh"
+#include "G4VSolid.hh"
+#include "G4AffineTransform.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Poisson.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GasFastSimModel::B1GasFastSimModel(const G4String& name, G4Region* envelope,
+				     B1RPCSensitiveDetector* gasDetector,
+				     const B1GasClusterParameters* parameters)
+  : G4VFastSimulationModel(name, envelope),
+    fGasDetector(gasDetector),
+    fParameters(parameters),
+    fTableSingleFraction(-1.)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GasFastSimModel::~B1GasFastSimModel()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1GasFastSimModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return particle.GetPDGCharge() != 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1GasFastSimModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+  if(!fParameters->enabled)
+    return false;
+
+  // The cluster density is that of minimum ionising particles
+  const G4DynamicParticle* particle = fastTrack.GetPrimaryTrack()->GetDynamicParticle();
+  G4double mass = particle->GetMass();
+  return mass > 0. && particle->GetTotalMomentum() >= fParameters->minBetaGamma*mass;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GasFastSimModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  G4ThreeVector localPos = fastTrack.GetPrimaryTrackLocalPosition();
+  G4ThreeVector localDir = fastTrack.GetPrimaryTrackLocalDirection();
+  const G4AffineTransform* toGlobal = fastTrack.GetInverseAffineTransformation();
+
+  // Straight chord to the exit of the gas pad
+  G4double chord = fastTrack.GetEnvelopeSolid()->DistanceToOut(localPos, localDir);
+  G4double velocity = track->GetVelocity();
+  G4double time = track->GetGlobalTime();
+  G4double kineticEnergy = track->GetKineticEnergy();
+  G4double w = fParameters->ionisationEnergy;
+
+  // Clusters ordered along the chord
+  G4long nClusters = G4Poisson(fParameters->clusterDensity*chord);
+  fClusterPositions.resize(nClusters);
+  for(auto& s : fClusterPositions)
+    s = chord*G4UniformRand();
+  std::sort(fClusterPositions.begin(), fClusterPositions.end());
+
+  fGasDetector->StartFastCrossing(track, track->GetPosition());
+  G4double deposit = 0.;
+  for(G4double s : fClusterPositions)
+    {
+      G4int size = SampleClusterSize();
+      G4double energy = size*w;
+      if(deposit + energy > kineticEnergy)
+	break;
+      deposit += energy;
+
+      G4ThreeVector pos = toGlobal->TransformPoint(localPos + s*localDir);
+      fGasDetector->AddFastHit(track, track->GetTouchable(), pos, time + s/velocity, -energy);
+      fGasDetector->AddFastCluster(track, size, energy);
+    }
+  fGasDetector->AddFastCrossing(track);
+
+  // Move the particle to the exit of the pad
+  fastStep.ProposePrimaryTrackFinalPosition(localPos + chord*localDir);
+  fastStep.ProposePrimaryTrackFinalTime(time + chord/velocity);
+  fastStep.ProposePrimaryTrackFinalKineticEnergy(kineticEnergy - deposit);
+  fastStep.ProposePrimaryTrackPathLength(chord);
+  fastStep.ProposeTotalEnergyDeposited(deposit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1GasFastSimModel::SampleClusterSize()
+{
+  const G4int kMaxClusterSize = 100;
+
+  if(fTableSingleFraction != fParameters->singleFraction)
+    {
+      // One electron clusters, then a 1/n^2 tail for the larger sizes
+      fTableSingleFraction = fParameters->singleFraction;
+      G4double tail = 0.;
+      for(G4int n=2; n<=kMaxClusterSize; n++)
+	tail += 1./(n*n);
+
+      fClusterSizeCDF.resize(kMaxClusterSize);
+      G4double sum = fTableSingleFraction;
+      fClusterSizeCDF[0] = sum;
+      for(G4int n=2; n<=kMaxClusterSize; n++)
+	{
+	  sum += (1. - fTableSingleFraction)/(n*n*tail);
+	  fClusterSizeCDF[n - 1] = sum;
+	}
+    }
+
+  auto it = std::upper_bound(fClusterSizeCDF.begin(), fClusterSizeCDF.end(), G4UniformRand());
+  return std::min<G4int>(it - fClusterSizeCDF.begin() + 1, kMaxClusterSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,184 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+//
+/// \file B1GasFieldManager.cc
+/// \brief Implementation of the B1GasFieldManager class
+
+#include "B1GasFieldManager.hh"
+#include "B1RunAction.hh"
+
+#include "G4Track.hh"
+#include "G4ParticleTable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ChordFinder.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+
+namespace
+{
+  // Coarse accuracy, never tighter than that of the integrated tracks
+  const G4double kCoarseDeltaChord = 1*mm;
+  const G4double kCoarseDeltaOneStep = 0.1*mm;
+  const G4double kCoarseDeltaIntersection = 0.01*mm;
+  const G4double kCoarseEpsilonMin = 1e-3;
+  const G4double kCoarseEpsilonMax = 1e-2;
+}
+
+B1GasFieldManager::B1GasFieldManager()
+  : G4FieldManager(),
+    fGasField(nullptr),
+    fMode(kFieldIntegrated),
+    fLastTrack(nullptr),
+    fLastTrackID(-1),
+    fLastStepNumber(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GasFieldManager::~B1GasFieldManager()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GasFieldManager::ConfigureForTrack(const G4Track* track)
+{
+  // Called before each step in the gas, the rule of the particle comes
+  // before the rule for all particles
+  B1FieldTrackMode mode = kFieldIntegrated;
+  if(!fRules.empty())
+    {
+      const G4ParticleDefinition* particle = track->GetDefinition();
+      const B1FieldTrackRule* rule = nullptr;
+      for(const auto& particleRule : fRules)
+	{
+	  if(particleRule.first == particle)
+	    {
+	      rule = &particleRule.second;
+	      break;
+	    }
+	  if(!particleRule.first)
+	    rule = &particleRule.second;
+	}
+      if(rule && track->GetMomentum().mag() >= rule->minMomentum)
+	mode = rule->mode;
+    }
+
+  // Count the track at its first step in the gas field, in the run
+  // action of this thread
+  G4int stepNumber = track->GetCurrentStepNumber();
+  if(track != fLastTrack || track->GetTrackID() != fLastTrackID
+     || stepNumber < fLastStepNumber)
+    {
+      fLastTrack = track;
+      fLastTrackID = track->GetTrackID();
+      B1RunAction* runAction = static_cast<B1RunAction*>
+	(const_cast<G4UserRunAction*>(G4RunManager::GetRunManager()->GetUserRunAction()));
+      if(runAction)
+	runAction->CountFieldTrack(mode);
+    }
+  fLastStepNumber = stepNumber;
+
+  if(mode != fMode)
+    ApplyMode(mode);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GasFieldManager::SetGasField(G4Field* field)
+{
+  fGasField = field;
+  ApplyMode(kFieldIntegrated);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GasFieldManager::SetParameters(const B1FieldParameters& parameters)
+{
+  fParameters = parameters;
+
+  fRules.clear();
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+  for(const B1FieldTrackRule& rule : parameters.trackRules)
+    {
+      const G4ParticleDefinition* particle = nullptr;
+      if(rule.particle != "all")
+	{
+	  particle = particleTable->FindParticle(rule.particle);
+	  if(!particle)
+	    {
+	      G4ExceptionDescription msg;
+	      msg << "Unknown particle " << rule.particle << ", field rule ignored";
+	      G4Exception("B1GasFieldManager::SetParameters()", "B1Field001",
+			  JustWarning, msg);
+	      continue;
+	    }
+	}
+      fRules.push_back(std::make_pair(particle, rule));
+    }
+
+  ApplyMode(kFieldIntegrated);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GasFieldManager::ApplyMode(B1FieldTrackMode mode)
+{
+  fMode = mode;
+  if(mode == kFieldStraight)
+    {
+      // Without a field the transportation moves the track in a straight line
+      SetDetectorField(nullptr);
+      return;
+    }
+
+  SetDetectorField(fGasField);
+  G4double deltaChord = fParameters.deltaChord;
+  G4double deltaOneStep = fParameters.deltaOneStep;
+  G4double deltaIntersection = fParameters.deltaIntersection;
+  G4double epsilonMin = fParameters.epsilonMin;
+  G4double epsilonMax = fParameters.epsilonMax;
+  if(mode == kFieldCoarse)
+    {
+      deltaChord = std::max(deltaChord, kCoarseDeltaChord);
+      deltaOneStep = std::max(deltaOneStep, kCoarseDeltaOneStep);
+      deltaIntersection = std::max(deltaIntersection, kCoarseDeltaIntersection);
+      epsilonMin = std::max(epsilonMin, kCoarseEpsilonMin);
+      epsilonMax = std::max(epsilonMax, kCoarseEpsilonMax);
+    }
+
+  if(GetChordFinder())
+    GetChordFinder()->SetDeltaChord(deltaChord);
+  SetDeltaOneStep(deltaOneStep);
+  SetDeltaIntersection(deltaIntersection);
+  SetMaximumEpsilonStep(epsilonMax);
+  SetMinimumEpsilonStep(epsilonMin);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
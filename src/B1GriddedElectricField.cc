@@ -0,0 +1,91 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1GriddedElectricField.cc
+/// \brief Implementation of the B1GriddedElectricField class
+
+#include "B1GriddedElectricField.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <string>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GriddedElectricField::B1GriddedElectricField(const G4String& fileName,
+					       const G4ThreeVector& outsideValue)
+  : G4ElectricField(),
+    fFileName(fileName),
+    fOutsideValue(outsideValue)
+{
+  std::string error;
+  if(!fMap.Open(fileName, error))
+    {
+      G4ExceptionDescription msg;
+      msg << "Field map " << fileName << " not loaded: " << error;
+      G4Exception("B1GriddedElectricField::B1GriddedElectricField()",
+		  "B1Field002", FatalException, msg);
+    }
+
+  const B1FieldMap::Header& header = fMap.GetHeader();
+  G4cout << " B1GriddedElectricField: " << fileName << ", "
+	 << header.nodes[0] << " x " << header.nodes[1] << " x "
+	 << header.nodes[2] << " nodes from ("
+	 << header.min[0] << ", " << header.min[1] << ", " << header.min[2]
+	 << ") to ("
+	 << header.max[0] << ", " << header.max[1] << ", " << header.max[2]
+	 << ") mm" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GriddedElectricField::~B1GriddedElectricField()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GriddedElectricField::GetFieldValue(const G4double point[4],
+					   G4double* field) const
+{
+  // Magnetic components first, as in G4UniformElectricField
+  field[0] = field[1] = field[2] = 0.;
+
+  G4double value[3];
+  if(fMap.Evaluate(point, value, fCache))
+    {
+      field[3] = value[0]*(kilovolt/cm);
+      field[4] = value[1]*(kilovolt/cm);
+      field[5] = value[2]*(kilovolt/cm);
+    }
+  else
+    {
+      field[3] = fOutsideValue.x();
+      field[4] = fOutsideValue.y();
+      field[5] = fOutsideValue.z();
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,117 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HitBuffer.cc
+/// \brief Implementation of the B1HitBuffer class
+
+#include "B1HitBuffer.hh"
+
+namespace
+{
+  // Initial capacities
+  const size_t kInitialHits = 512;
+  const size_t kInitialAvalanche = 64;
+
+  template <typename T>
+  void Grow(std::vector<T>& column, size_t capacity)
+  {
+    if(column.capacity() < capacity)
+      column.reserve(capacity);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HitBuffer::Stream::Grow(size_t capacity)
+{
+  ::Grow(hitPosX, capacity);
+  ::Grow(hitPosY, capacity);
+  ::Grow(hitPosZ, capacity);
+  ::Grow(time, capacity);
+  ::Grow(energy, capacity);
+  ::Grow(particleID, capacity);
+  ::Grow(trackID, capacity);
+  ::Grow(parentID, capacity);
+  ::Grow(primaryID, capacity);
+  ::Grow(channelID, capacity);
+  ::Grow(hitEntryPosX, capacity);
+  ::Grow(hitEntryPosY, capacity);
+  ::Grow(hitEntryPosZ, capacity);
+  ::Grow(hitSteps, capacity);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HitBuffer::B1HitBuffer()
+  : finalEnergy(1, 0.),
+    avalancheSize(1, 0),
+    layerCount(1, 0),
+    weight(1, 1.),
+    clusterCount(1, 0),
+    fGasHighWater(0),
+    fPlateHighWater(0),
+    fAvalancheHighWater(0)
+{
+  gas.Grow(kInitialHits);
+  plate.Grow(kInitialHits);
+  ::Grow(avalancheEnergy, kInitialAvalanche);
+  ::Grow(avalanchePrimaryID, kInitialAvalanche);
+  ::Grow(clusterSize, kInitialAvalanche);
+  ::Grow(clusterPrimaryID, kInitialAvalanche);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HitBuffer::~B1HitBuffer()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HitBuffer::Reserve(size_t nGasHits, size_t nPlateHits, size_t nAvalanche)
+{
+  // Grow to half as much again as the largest event, so that a slowly
+  // growing sequence of events does not reallocate every time
+  if(nGasHits > fGasHighWater)
+    {
+      fGasHighWater = nGasHits;
+      gas.Grow(nGasHits + nGasHits/2);
+    }
+  if(nPlateHits > fPlateHighWater)
+    {
+      fPlateHighWater = nPlateHits;
+      plate.Grow(nPlateHits + nPlateHits/2);
+    }
+  if(nAvalanche > fAvalancheHighWater)
+    {
+      fAvalancheHighWater = nAvalanche;
+      ::Grow(avalancheEnergy, nAvalanche + nAvalanche/2);
+      ::Grow(avalanchePrimaryID, nAvalanche + nAvalanche/2);
+      ::Grow(clusterSize, nAvalanche + nAvalanche/2);
+      ::Grow(clusterPrimaryID, nAvalanche + nAvalanche/2);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,243 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1LLPGenerator.cc
+/// \brief Implementation of the B1LLPGenerator class
+
+#include "B1LLPGenerator.hh"
+#include "B1AcceptanceBias.hh"
+
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4ParticleTable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1LLPGenerator::B1LLPGenerator()
+  : G4VPrimaryGenerator(),
+    fMass(1*GeV),
+    fLifetime(10*ns),
+    fOrigin(0, 0, -25*m),
+    fHalfSize(0.),
+    fNofTrials(0)
+{
+  fDaughter[0] = fDaughter[1] = nullptr;
+  SetDaughters("pi+", "pi-");
+  SetSpectrum("");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1LLPGenerator::~B1LLPGenerator()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1LLPGenerator::SetDaughters(const G4String& name1, const G4String& name2)
+{
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+  G4ParticleDefinition* daughter1 = particleTable->FindParticle(name1);
+  G4ParticleDefinition* daughter2 = particleTable->FindParticle(name2);
+  if(!daughter1 || !daughter2)
+    {
+      G4ExceptionDescription msg;
+      msg << "Unknown LLP daughters " << name1 << " " << name2
+	  << ", the previous ones are kept";
+      G4Exception("B1LLPGenerator::SetDaughters()", "B1LLP002", JustWarning, msg);
+      return;
+    }
+  fDaughter[0] = daughter1;
+  fDaughter[1] = daughter2;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1LLPGenerator::SetSpectrum(const G4String& fileName)
+{
+  // Default: flat between 10 and 100 GeV
+  std::vector<G4double> edges;
+  std::vector<G4double> weights;
+  if(fileName.empty())
+    {
+      edges = { 10*GeV, 100*GeV };
+      weights = { 1. };
+    }
+  else
+    {
+      // Contiguous "pMin pMax weight" bins in GeV, the lines not starting
+      // with a number (blank, # comments) are skipped
+      std::ifstream file(fileName);
+      std::string line, error;
+      if(!file)
+	error = "cannot be opened";
+      while(error.empty() && std::getline(file, line))
+	{
+	  std::istringstream is(line);
+	  G4double pMin, pMax, weight;
+	  if(!(is >> pMin))
+	    continue;
+	  if(!(is >> pMax >> weight) || pMin < 0. || pMax <= pMin || weight < 0.
+	     || (!edges.empty() && pMin*GeV != edges.back()))
+	    error = "bad bin \"" + line + "\"";
+	  else
+	    {
+	      if(edges.empty())
+		edges.push_back(pMin*GeV);
+	      edges.push_back(pMax*GeV);
+	      weights.push_back(weight);
+	    }
+	}
+      if(error.empty() && weights.empty())
+	error = "has no bins";
+      if(!error.empty())
+	{
+	  G4ExceptionDescription msg;
+	  msg << "LLP momentum spectrum " << fileName << " " << error
+	      << ", the previous one is kept";
+	  G4Exception("B1LLPGenerator::SetSpectrum()", "B1LLP003", JustWarning, msg);
+	  return;
+	}
+    }
+
+  // Cumulative probabilities of the bins
+  std::vector<G4double> cumulative(weights.size());
+  G4double total = 0.;
+  for(size_t i=0; i<weights.size(); i++)
+    cumulative[i] = (total += weights[i]);
+  if(total <= 0.)
+    {
+      G4Exception("B1LLPGenerator::SetSpectrum()", "B1LLP003", JustWarning,
+		  "LLP momentum spectrum of zero weight, the previous one is kept");
+      return;
+    }
+  for(G4double& value : cumulative)
+    value /= total;
+  fMomentumEdges.swap(edges);
+  fCumulative.swap(cumulative);
+
+  if(!fileName.empty())
+    G4cout << " B1LLPGenerator: " << fCumulative.size() << " momentum bins from "
+	   << fMomentumEdges.front()/GeV << " to " << fMomentumEdges.back()/GeV
+	   << " GeV/c in " << fileName << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1LLPGenerator::SampleMomentum() const
+{
+  // Bin from the cumulative probabilities, uniform within the bin
+  G4double u = G4UniformRand();
+  size_t i = std::upper_bound(fCumulative.begin(), fCumulative.end(), u)
+    - fCumulative.begin();
+  i = std::min(i, fCumulative.size() - 1);
+  return fMomentumEdges[i] + G4UniformRand()*(fMomentumEdges[i + 1] - fMomentumEdges[i]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1LLPGenerator::GeneratePrimaryVertex(G4Event* event)
+{
+  G4double mass1 = fDaughter[0]->GetPDGMass();
+  G4double mass2 = fDaughter[1]->GetPDGMass();
+  if(fMass <= mass1 + mass2)
+    {
+      G4ExceptionDescription msg;
+      msg << "LLP of " << fMass/GeV << " GeV/c2 below the threshold of "
+	  << fDaughter[0]->GetParticleName() << " " << fDaughter[1]->GetParticleName();
+      G4Exception("B1LLPGenerator::GeneratePrimaryVertex()", "B1LLP001",
+		  RunMustBeAborted, msg);
+      return;
+    }
+
+  // Direction of the parent through the box, aimed at it, or isotropic
+  // from inside the box
+  G4ThreeVector direction;
+  G4double solidAngle, tIn, tOut;
+  fNofTrials = 0;
+  do
+    {
+      fNofTrials++;
+      solidAngle = B1AcceptanceBias::SampleDirection(fOrigin, fHalfSize, direction);
+      if(solidAngle == 0.)
+	{
+	  G4double cosTheta = 2*G4UniformRand() - 1.;
+	  G4double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+	  G4double phi = twopi*G4UniformRand();
+	  direction.set(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+	  solidAngle = 4*pi;
+	}
+    }
+  while(!B1AcceptanceBias::CubeChord(fOrigin, direction, fHalfSize, tIn, tOut));
+
+  // Decay forced on the chord, from the exponential of the decay length
+  // truncated to [tIn, tOut]
+  G4double momentum = SampleMomentum();
+  G4double energy = std::sqrt(momentum*momentum + fMass*fMass);
+  G4double decayLength = momentum/fMass*c_light*fLifetime;
+  G4double chord = -std::expm1(-(tOut - tIn)/decayLength);
+  G4double distance = tIn - decayLength*std::log1p(-G4UniformRand()*chord);
+  distance = std::min(distance, tOut);
+  G4double weight = std::exp(-tIn/decayLength)*chord*solidAngle/(4*pi);
+
+  G4PrimaryVertex* vertex
+    = new G4PrimaryVertex(fOrigin + distance*direction,
+			  distance*energy/(momentum*c_light));
+  vertex->SetWeight(weight);
+
+  // Two-body decay, isotropic in the rest frame, boosted along the parent
+  G4double sum = mass1 + mass2, difference = mass1 - mass2;
+  G4double restMomentum = std::sqrt((fMass*fMass - sum*sum)*(fMass*fMass - difference*difference))
+    /(2*fMass);
+  G4double cosTheta = 2*G4UniformRand() - 1.;
+  G4double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+  G4double phi = twopi*G4UniformRand();
+  G4ThreeVector restDirection(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+  G4double gamma = energy/fMass, betaGamma = momentum/fMass;
+  for(G4int i=0; i<2; i++)
+    {
+      G4double daughterMass = (i == 0) ? mass1 : mass2;
+      G4ThreeVector restP = ((i == 0) ? restMomentum : -restMomentum)*restDirection;
+      G4double restE = std::sqrt(restMomentum*restMomentum + daughterMass*daughterMass);
+      G4double parallel = restP.dot(direction);
+      G4ThreeVector p = restP + ((gamma - 1.)*parallel + betaGamma*restE)*direction;
+      vertex->SetPrimary(new G4PrimaryParticle(fDaughter[i], p.x(), p.y(), p.z()));
+    }
+
+  event->AddPrimaryVertex(vertex);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,145 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1NavigationBenchmark.cc
+/// \brief Implementation of the B1NavigationBenchmark class
+
+#include "B1NavigationBenchmark.hh"
+
+#include "G4Navigator.hh"
+#include "G4GeometryManager.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4UserLimits.hh"
+#include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Geantino.hh"
+#include "G4Timer.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1NavigationBenchmark::B1NavigationBenchmark(G4VPhysicalVolume* world)
+  : fWorld(world)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1NavigationBenchmark::~B1NavigationBenchmark()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1NavigationBenchmark::Run(G4int nRays)
+{
+  // Voxelise as for tracking, nothing is done if the geometry is closed
+  G4GeometryManager::GetInstance()->CloseGeometry(true);
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(fWorld);
+
+  // Rays start on the sphere inscribed in the world and are aimed at the
+  // central half of the world, which contains the detector
+  G4ThreeVector worldMin, worldMax;
+  fWorld->GetLogicalVolume()->GetSolid()->BoundingLimits(worldMin, worldMax);
+  G4double halfWorld = 0.5*std::min(std::min(worldMax.x() - worldMin.x(),
+					     worldMax.y() - worldMin.y()),
+				    worldMax.z() - worldMin.z());
+  G4double startRadius = 0.999*halfWorld;
+  G4double targetHalf = 0.5*halfWorld;
+
+  // Track used to query the step limits of the volumes
+  G4Track track(new G4DynamicParticle(G4Geantino::Definition(), G4ThreeVector(0, 0, 1), 0.),
+		0., G4ThreeVector());
+
+  G4double nSteps = 0;
+  G4double nBoundaries = 0;
+  G4Timer timer;
+  timer.Start();
+
+  for(G4int ray=0; ray<nRays; ray++)
+    {
+      G4ThreeVector pos = startRadius*G4RandomDirection();
+      G4ThreeVector target(targetHalf*(2*G4UniformRand() - 1),
+			   targetHalf*(2*G4UniformRand() - 1),
+			   targetHalf*(2*G4UniformRand() - 1));
+      G4ThreeVector dir = (target - pos).unit();
+
+      G4VPhysicalVolume* volume
+	= navigator.LocateGlobalPointAndSetup(pos, &dir, false, false);
+      while(volume)
+	{
+	  G4double limit = kInfinity;
+	  G4UserLimits* userLimits = volume->GetLogicalVolume()->GetUserLimits();
+	  if(userLimits)
+	    limit = userLimits->GetMaxAllowedStep(track);
+
+	  G4double safety;
+	  G4double step = navigator.ComputeStep(pos, dir, limit, safety);
+	  nSteps++;
+	  if(step == kInfinity && limit == kInfinity)
+	    break;
+
+	  if(step >= limit)
+	    {
+	      // Limited by the step limit, still in the same volume
+	      pos += limit*dir;
+	      navigator.LocateGlobalPointWithinVolume(pos);
+	    }
+	  else
+	    {
+	      pos += step*dir;
+	      navigator.SetGeometricallyLimitedStep();
+	      volume = navigator.LocateGlobalPointAndSetup(pos, &dir, true);
+	      nBoundaries++;
+	    }
+	}
+    }
+
+  timer.Stop();
+  G4double realTime = timer.GetRealElapsed();
+
+  G4cout
+     << G4endl
+     << "--------------------Navigation benchmark--------------------"
+     << G4endl
+     << " " << nRays << " rays, " << nSteps << " steps, "
+     << nBoundaries << " boundaries crossed in " << realTime << " s";
+  if(realTime > 0. && nSteps > 0)
+    G4cout
+       << G4endl
+       << " " << nSteps/realTime << " steps/s, "
+       << realTime*s/nSteps/ns << " ns of navigation per step";
+  G4cout
+     << G4endl
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,153 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1OverlapCache.cc
+/// \brief Implementation of the B1OverlapCache class
+
+#include "B1OverlapCache.hh"
+
+#include "G4PhysicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Material.hh"
+#include "G4Timer.hh"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1OverlapCache::B1OverlapCache(const G4String& fileName, G4int resolution)
+  : fFileName(fileName),
+    fResolution(resolution)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1OverlapCache::~B1OverlapCache()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1OverlapCache::Check(const std::vector<G4VPhysicalVolume*>& placements)
+{
+  uint64_t hash = GeometryHash();
+
+  G4int nOverlaps = 0;
+  if(Lookup(hash, nOverlaps))
+    {
+      G4cout << "Overlap check skipped, geometry " << std::hex << hash << std::dec
+	     << " found in " << fFileName << " with " << nOverlaps
+	     << " overlapping volumes" << G4endl;
+
+      // Same warning as the fresh check, which reports each overlap
+      if(nOverlaps > 0)
+	{
+	  G4ExceptionDescription msg;
+	  msg << "Overlaps detected for " << nOverlaps << " volumes of geometry "
+	      << std::hex << hash << std::dec << " in the cache " << fFileName
+	      << "." << G4endl
+	      << "Remove its entry and check again for the overlapping volumes.";
+	  G4Exception("B1OverlapCache::Check()", "GeomVol1002", JustWarning, msg);
+	}
+      return nOverlaps;
+    }
+
+  G4Timer timer;
+  timer.Start();
+  for(auto volume : placements)
+    if(volume->CheckOverlaps(fResolution))
+      nOverlaps++;
+  timer.Stop();
+
+  G4cout << "Overlap check of " << placements.size() << " volumes: "
+	 << nOverlaps << " overlapping, in " << timer.GetRealElapsed() << " s" << G4endl;
+
+  Store(hash, nOverlaps);
+  return nOverlaps;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+uint64_t B1OverlapCache::GeometryHash() const
+{
+  // FNV-1a over a text description of the placed volumes, which includes
+  // the sampling resolution so that a finer check is not skipped
+  std::ostringstream description;
+  description << std::setprecision(17) << fResolution << '\n';
+  for(auto volume : *G4PhysicalVolumeStore::GetInstance())
+    {
+      G4LogicalVolume* logical = volume->GetLogicalVolume();
+      G4LogicalVolume* mother = volume->GetMotherLogical();
+      description << volume->GetName() << ' ' << volume->GetCopyNo() << ' '
+		  << (mother ? mother->GetName() : "") << ' '
+		  << logical->GetName() << ' '
+		  << (logical->GetMaterial() ? logical->GetMaterial()->GetName() : "") << ' '
+		  << volume->GetTranslation() << ' ';
+      if(volume->GetRotation())
+	description << *volume->GetRotation();
+      logical->GetSolid()->StreamInfo(description);
+    }
+
+  const std::string& text = description.str();
+  uint64_t hash = 14695981039346656037ull;
+  for(unsigned char c : text)
+    {
+      hash ^= c;
+      hash *= 1099511628211ull;
+    }
+  return hash;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1OverlapCache::Lookup(uint64_t hash, G4int& nOverlaps) const
+{
+  std::ifstream file(fFileName);
+  uint64_t cachedHash;
+  G4int cachedOverlaps;
+  while(file >> std::hex >> cachedHash >> std::dec >> cachedOverlaps)
+    {
+      if(cachedHash == hash)
+	{
+	  nOverlaps = cachedOverlaps;
+	  return true;
+	}
+    }
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1OverlapCache::Store(uint64_t hash, G4int nOverlaps) const
+{
+  std::ofstream file(fFileName, std::ios::app);
+  file << std::hex << hash << std::dec << ' ' << nOverlaps << '\n';
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
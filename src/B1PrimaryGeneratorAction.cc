@@ -28,23 +28,58 @@
 /// \brief Implementation of the B1PrimaryGeneratorAction class
 
 #include "B1PrimaryGeneratorAction.hh"
+#include "B1PrimaryGeneratorMessenger.hh"
+#include "B1AcceptanceBias.hh"
+#include "B1CosmicMuonGenerator.hh"
+#include "B1EventFileGenerator.hh"
+#include "B1LLPGenerator.hh"
+#include "B1DetectorConstruction.hh"
+#include "B1RunAction.hh"
 
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Box.hh"
 #include "G4RunManager.hh"
+#include "G4TransportationManager.hh"
+#include "G4Navigator.hh"
+#include "G4VPhysicalVolume.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4UnitsTable.hh"
+#include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
 
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+  // Trials of the veto before a missing primary is kept anyway
+  const G4int kMaxTrials = 1000000;
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-B1PrimaryGeneratorAction::B1PrimaryGeneratorAction()
+B1PrimaryGeneratorAction::B1PrimaryGeneratorAction(B1RunAction* runAction)
 : G4VUserPrimaryGeneratorAction(),
   fParticleGun(0), 
-  fEnvelopeBox(0)
+  fEnvelopeBox(0),
+  fRunAction(runAction),
+  fCosmic(false),
+  fIsotropic(false),
+  fConeBias(false),
+  fVeto(false),
+  fVetoWarned(false),
+  fConeWarned(false),
+  fCosmicGenerator(0),
+  fEventFileGenerator(0),
+  fLLP(false),
+  fLLPGenerator(0),
+  fMessenger(0)
 {
   G4int n_particle = 1;
   fParticleGun  = new G4ParticleGun(n_particle);
@@ -57,12 +92,21 @@ B1PrimaryGeneratorAction::B1PrimaryGeneratorAction()
   fParticleGun->SetParticleDefinition(particle);
   fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.));
   fParticleGun->SetParticleEnergy(10*GeV);
+
+  fCosmicGenerator = new B1CosmicMuonGenerator();
+  fEventFileGenerator = new B1EventFileGenerator();
+  fLLPGenerator = new B1LLPGenerator();
+  fMessenger = new B1PrimaryGeneratorMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1PrimaryGeneratorAction::~B1PrimaryGeneratorAction()
 {
+  delete fMessenger;
+  delete fCosmicGenerator;
+  delete fEventFileGenerator;
+  delete fLLPGenerator;
   delete fParticleGun;
 }
 
@@ -70,10 +114,162 @@ B1PrimaryGeneratorAction::~B1PrimaryGeneratorAction()
 
 void B1PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
-  fParticleGun->SetParticlePosition(G4ThreeVector(0,0,-7*m));
+  if(fEventFileGenerator->IsOpen())
+  {
+    fEventFileGenerator->GeneratePrimaryVertex(anEvent);
+    return;
+  }
+
+  if(fLLP)
+  {
+    // Decays in the centre volume of the cube
+    const B1DetectorConstruction* detector
+      = static_cast<const B1DetectorConstruction*>
+        (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    fLLPGenerator->SetFiducialHalfSize(0.5*detector->GetLayout().detSize*mm);
+    fLLPGenerator->GeneratePrimaryVertex(anEvent);
+    G4PrimaryVertex* vertex = anEvent->GetPrimaryVertex(0);
+    fRunAction->AddPrimary(fLLPGenerator->GetNofTrials(), vertex ? vertex->GetWeight() : 0.);
+    return;
+  }
+
+  G4double halfSize = 0., worldHalfSize = 0.;
+  if(fCosmic || fConeBias || fVeto)
+    GetHalfSizes(halfSize, worldHalfSize);
+
+  // Trials missing the cube are vetoed before transport, they still count
+  // in the live time
+  G4double weight = 1.;
+  G4int nTrials = 0;
+  G4bool accepted = false;
+  do
+  {
+    G4double liveTime = SampleGun(halfSize, worldHalfSize, weight);
+    if(fCosmic)
+      fRunAction->AddLiveTime(liveTime);
+    nTrials++;
+    accepted = !fVeto
+      || (weight > 0.
+	  && B1AcceptanceBias::HitsCube(fParticleGun->GetParticlePosition(),
+					fParticleGun->GetParticleMomentumDirection(),
+					halfSize));
+  }
+  while(!accepted && nTrials < kMaxTrials);
+
+  if(!accepted && !fVetoWarned)
+  {
+    G4ExceptionDescription msg;
+    msg << "No primary hit the detector cube in " << kMaxTrials
+	<< " trials, the last one is transported." << G4endl
+	<< "This warning is only printed once.";
+    G4Exception("B1PrimaryGeneratorAction::GeneratePrimaries()",
+		"B1Bias001", JustWarning, msg);
+    fVetoWarned = true;
+  }
+  fRunAction->AddPrimary(nTrials, weight);
 
   fParticleGun->GeneratePrimaryVertex(anEvent);
+  anEvent->GetPrimaryVertex(0)->SetWeight(weight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1PrimaryGeneratorAction::GetDescription() const
+{
+  // Same order of precedence as in GeneratePrimaries()
+  if(fEventFileGenerator->IsOpen())
+    return "events of the input file";
+
+  std::ostringstream description;
+  if(fLLP)
+    description << "decays of a " << G4BestUnit(fLLPGenerator->GetMass(), "Energy")
+		<< " long-lived particle";
+  else if(fCosmic)
+    description << "cosmic muons";
+  else
+  {
+    description << fParticleGun->GetParticleDefinition()->GetParticleName()
+		<< " of " << G4BestUnit(fParticleGun->GetParticleEnergy(), "Energy");
+    if(fIsotropic)
+      description << ", isotropic";
+  }
+  return description.str();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void B1PrimaryGeneratorAction::SetIsotropic(G4bool value)
+{
+  if(value && !fIsotropic)
+    fGunDirection = fParticleGun->GetParticleMomentumDirection();
+  else if(!value && fIsotropic)
+    fParticleGun->SetParticleMomentumDirection(fGunDirection);
+  fIsotropic = value;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1PrimaryGeneratorAction::SampleGun(G4double halfSize, G4double worldHalfSize,
+					     G4double& weight)
+{
+  weight = 1.;
+  if(fCosmic)
+    return fCosmicGenerator->Generate(halfSize, worldHalfSize, fParticleGun,
+				      weight, fConeBias);
+
+  G4ThreeVector position(0,0,-7*m);
+  fParticleGun->SetParticlePosition(position);
+  if(fIsotropic)
+  {
+    // Natural density 1/(4 pi), aimed at the cube with the inverse
+    // density of the biased direction
+    G4ThreeVector direction;
+    G4double cone = fConeBias
+      ? B1AcceptanceBias::SampleDirection(position, halfSize, direction) : 0.;
+    if(cone > 0.)
+      weight = cone/(4*pi);
+    else
+    {
+      if(fConeBias && !fConeWarned)
+      {
+	G4ExceptionDescription msg;
+	msg << "The gun is inside the detector cube, /rpc/bias/cone is ignored"
+	    << " and the gun stays isotropic." << G4endl
+	    << "This warning is only printed once.";
+	G4Exception("B1PrimaryGeneratorAction::SampleGun()",
+		    "B1Bias002", JustWarning, msg);
+	fConeWarned = true;
+      }
+      G4double cosTheta = 2*G4UniformRand() - 1.;
+      G4double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+      G4double phi = twopi*G4UniformRand();
+      direction.set(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+    }
+    fParticleGun->SetParticleMomentumDirection(direction);
+  }
+  return 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::GetHalfSizes(G4double& halfSize,
+					    G4double& worldHalfSize) const
+{
+  // Cube of the RPC faces, within the world box
+  const B1DetectorConstruction* detector
+    = static_cast<const B1DetectorConstruction*>
+      (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  B1RPCLayout layout = detector->GetLayout();
+  halfSize = (layout.FaceOffset() + 0.5*layout.FaceThickness())*mm;
+
+  G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()
+    ->GetNavigatorForTracking()->GetWorldVolume();
+  const G4Box* worldBox
+    = dynamic_cast<const G4Box*>(world->GetLogicalVolume()->GetSolid());
+  worldHalfSize = worldBox
+    ? std::min(worldBox->GetXHalfLength(),
+	       std::min(worldBox->GetYHalfLength(), worldBox->GetZHalfLength()))
+    : halfSize;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
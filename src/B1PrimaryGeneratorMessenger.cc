@@ -0,0 +1,301 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PrimaryGeneratorMessenger.cc
+/// \brief Implementation of the B1PrimaryGeneratorMessenger class
+
+#include "B1PrimaryGeneratorMessenger.hh"
+#include "B1PrimaryGeneratorAction.hh"
+#include "B1CosmicMuonGenerator.hh"
+#include "B1EventFileGenerator.hh"
+#include "B1LLPGenerator.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+#include "G4SystemOfUnits.hh"
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrimaryGeneratorMessenger::B1PrimaryGeneratorMessenger(B1PrimaryGeneratorAction* action)
+ : G4UImessenger(),
+   fPrimaryGeneratorAction(action)
+{
+  fCosmicDirectory = new G4UIdirectory("/rpc/cosmic/");
+  fCosmicDirectory->SetGuidance("Sea-level cosmic muons around the detector cube (+y up)");
+
+  fEnableCmd = new G4UIcmdWithABool("/rpc/cosmic/enable",this);
+  fEnableCmd->SetGuidance("Generate cosmic muons in place of the fixed gun.");
+  fEnableCmd->SetGuidance("The live time of the muons is printed at the end of the run.");
+  fEnableCmd->SetParameterName("enable",true);
+  fEnableCmd->SetDefaultValue(true);
+  fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSurfaceCmd = new G4UIcmdWithAString("/rpc/cosmic/surface",this);
+  fSurfaceCmd->SetGuidance("Start the muons on a horizontal plane above the cube (default)");
+  fSurfaceCmd->SetGuidance("or on a sphere around it.");
+  fSurfaceCmd->SetParameterName("surface",false);
+  fSurfaceCmd->SetCandidates("plane sphere");
+  fSurfaceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMomentumRangeCmd = new G4UIcommand("/rpc/cosmic/momentumRange",this);
+  fMomentumRangeCmd->SetGuidance("Momentum range of the muons (default 1 GeV to 2 TeV).");
+  G4UIparameter* minPrm = new G4UIparameter("pMin",'d',false);
+  minPrm->SetParameterRange("pMin>0.");
+  fMomentumRangeCmd->SetParameter(minPrm);
+  G4UIparameter* maxPrm = new G4UIparameter("pMax",'d',false);
+  maxPrm->SetParameterRange("pMax>0.");
+  fMomentumRangeCmd->SetParameter(maxPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultValue("GeV");
+  fMomentumRangeCmd->SetParameter(unitPrm);
+  fMomentumRangeCmd->SetRange("pMax>pMin");
+  fMomentumRangeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMaxZenithCmd = new G4UIcmdWithADoubleAndUnit("/rpc/cosmic/maxZenith",this);
+  fMaxZenithCmd->SetGuidance("Largest zenith angle of the muons (default 80 deg).");
+  fMaxZenithCmd->SetParameterName("angle",false);
+  fMaxZenithCmd->SetRange("angle>0. && angle<=90.");
+  fMaxZenithCmd->SetUnitCategory("Angle");
+  fMaxZenithCmd->SetDefaultUnit("deg");
+  fMaxZenithCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fChargeRatioCmd = new G4UIcmdWithADouble("/rpc/cosmic/chargeRatio",this);
+  fChargeRatioCmd->SetGuidance("Ratio of mu+ to mu- (default 1.27).");
+  fChargeRatioCmd->SetParameterName("ratio",false);
+  fChargeRatioCmd->SetRange("ratio>=0.");
+  fChargeRatioCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPlaneHalfWidthCmd = new G4UIcmdWithADoubleAndUnit("/rpc/cosmic/planeHalfWidth",this);
+  fPlaneHalfWidthCmd->SetGuidance("Half width of the starting plane, 0 (the default) for the");
+  fPlaneHalfWidthCmd->SetGuidance("width reached by the muons of the zenith range at the bottom");
+  fPlaneHalfWidthCmd->SetGuidance("of the cube. The plane is cut at the edges of the world.");
+  fPlaneHalfWidthCmd->SetParameterName("width",false);
+  fPlaneHalfWidthCmd->SetRange("width>=0.");
+  fPlaneHalfWidthCmd->SetUnitCategory("Length");
+  fPlaneHalfWidthCmd->SetDefaultUnit("m");
+  fPlaneHalfWidthCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fInputDirectory = new G4UIdirectory("/rpc/input/");
+  fInputDirectory->SetGuidance("Primaries read from an external event file");
+
+  fInputFileCmd = new G4UIcmdWithAString("/rpc/input/file",this);
+  fInputFileCmd->SetGuidance("Read the events from a B1EventFile (tools/eventfile) or a");
+  fInputFileCmd->SetGuidance("HepMC3 ASCII file, shared by the threads. The file is read");
+  fInputFileCmd->SetGuidance("once across the runs. An empty name restores the gun.");
+  fInputFileCmd->SetParameterName("fileName",true);
+  fInputFileCmd->SetDefaultValue("");
+  fInputFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fChunkCmd = new G4UIcmdWithAnInteger("/rpc/input/chunk",this);
+  fChunkCmd->SetGuidance("Events taken at a time by a thread from the file (default 64).");
+  fChunkCmd->SetParameterName("nEvents",false);
+  fChunkCmd->SetRange("nEvents>0");
+  fChunkCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fGunDirectory = new G4UIdirectory("/rpc/gun/");
+  fGunDirectory->SetGuidance("Fixed particle gun at (0,0,-7 m)");
+
+  fIsotropicCmd = new G4UIcmdWithABool("/rpc/gun/isotropic",this);
+  fIsotropicCmd->SetGuidance("Throw the gun in all directions, the /gun/direction is");
+  fIsotropicCmd->SetGuidance("restored when disabled.");
+  fIsotropicCmd->SetParameterName("isotropic",true);
+  fIsotropicCmd->SetDefaultValue(true);
+  fIsotropicCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBiasDirectory = new G4UIdirectory("/rpc/bias/");
+  fBiasDirectory->SetGuidance("Acceptance biasing of the gun and of the cosmic muons");
+
+  fConeCmd = new G4UIcmdWithABool("/rpc/bias/cone",this);
+  fConeCmd->SetGuidance("Aim the isotropic gun and the cosmic muons from the plane at");
+  fConeCmd->SetGuidance("the detector cube: at the sphere around it from outside the");
+  fConeCmd->SetGuidance("sphere, at its faces from inside. The importance sampling");
+  fConeCmd->SetGuidance("weight of each event is written in the Weight column.");
+  fConeCmd->SetParameterName("cone",true);
+  fConeCmd->SetDefaultValue(true);
+  fConeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fVetoCmd = new G4UIcmdWithABool("/rpc/bias/veto",this);
+  fVetoCmd->SetGuidance("Generate the primaries again until they point at the detector");
+  fVetoCmd->SetGuidance("cube, the vetoed ones are not transported.");
+  fVetoCmd->SetParameterName("veto",true);
+  fVetoCmd->SetDefaultValue(true);
+  fVetoCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fLLPDirectory = new G4UIdirectory("/rpc/llp/");
+  fLLPDirectory->SetGuidance("Long-lived particle decays in the centre volume");
+
+  fLLPEnableCmd = new G4UIcmdWithABool("/rpc/llp/enable",this);
+  fLLPEnableCmd->SetGuidance("Generate the two daughters of a long-lived particle decaying");
+  fLLPEnableCmd->SetGuidance("in the centre volume, in place of the gun and the cosmic muons.");
+  fLLPEnableCmd->SetGuidance("The weight of the forced decay is written in the Weight column.");
+  fLLPEnableCmd->SetParameterName("enable",true);
+  fLLPEnableCmd->SetDefaultValue(true);
+  fLLPEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMassCmd = new G4UIcmdWithADoubleAndUnit("/rpc/llp/mass",this);
+  fMassCmd->SetGuidance("Mass of the long-lived particle (default 1 GeV).");
+  fMassCmd->SetParameterName("mass",false);
+  fMassCmd->SetRange("mass>0.");
+  fMassCmd->SetUnitCategory("Energy");
+  fMassCmd->SetDefaultUnit("GeV");
+  fMassCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fLifetimeCmd = new G4UIcmdWithADoubleAndUnit("/rpc/llp/lifetime",this);
+  fLifetimeCmd->SetGuidance("Proper lifetime of the long-lived particle (default 10 ns).");
+  fLifetimeCmd->SetParameterName("lifetime",false);
+  fLifetimeCmd->SetRange("lifetime>0.");
+  fLifetimeCmd->SetUnitCategory("Time");
+  fLifetimeCmd->SetDefaultUnit("ns");
+  fLifetimeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fOriginCmd = new G4UIcmdWith3VectorAndUnit("/rpc/llp/origin",this);
+  fOriginCmd->SetGuidance("Production point of the long-lived particle, the interaction");
+  fOriginCmd->SetGuidance("point (default 0 0 -25 m). It may lie outside the world.");
+  fOriginCmd->SetParameterName("x","y","z",false);
+  fOriginCmd->SetUnitCategory("Length");
+  fOriginCmd->SetDefaultUnit("m");
+  fOriginCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fDaughtersCmd = new G4UIcommand("/rpc/llp/daughters",this);
+  fDaughtersCmd->SetGuidance("Daughters of the two-body decay (default pi+ pi-).");
+  fDaughtersCmd->SetParameter(new G4UIparameter("name1",'s',false));
+  fDaughtersCmd->SetParameter(new G4UIparameter("name2",'s',false));
+  fDaughtersCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSpectrumCmd = new G4UIcmdWithAString("/rpc/llp/spectrum",this);
+  fSpectrumCmd->SetGuidance("Momentum histogram of the long-lived particle, a table of");
+  fSpectrumCmd->SetGuidance("contiguous \"pMin pMax weight\" bins in GeV. An empty name");
+  fSpectrumCmd->SetGuidance("restores the default, flat between 10 and 100 GeV.");
+  fSpectrumCmd->SetParameterName("fileName",true);
+  fSpectrumCmd->SetDefaultValue("");
+  fSpectrumCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrimaryGeneratorMessenger::~B1PrimaryGeneratorMessenger()
+{
+  delete fEnableCmd;
+  delete fSurfaceCmd;
+  delete fMomentumRangeCmd;
+  delete fMaxZenithCmd;
+  delete fChargeRatioCmd;
+  delete fPlaneHalfWidthCmd;
+  delete fCosmicDirectory;
+  delete fInputFileCmd;
+  delete fChunkCmd;
+  delete fInputDirectory;
+  delete fIsotropicCmd;
+  delete fGunDirectory;
+  delete fConeCmd;
+  delete fVetoCmd;
+  delete fBiasDirectory;
+  delete fLLPEnableCmd;
+  delete fMassCmd;
+  delete fLifetimeCmd;
+  delete fOriginCmd;
+  delete fDaughtersCmd;
+  delete fSpectrumCmd;
+  delete fLLPDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  B1CosmicMuonGenerator* generator = fPrimaryGeneratorAction->GetCosmicGenerator();
+  B1LLPGenerator* llp = fPrimaryGeneratorAction->GetLLPGenerator();
+  if( command == fEnableCmd ) {
+    fPrimaryGeneratorAction->SetCosmic(fEnableCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fSurfaceCmd ) {
+    generator->SetSphere(newValue == "sphere");
+  }
+  else if( command == fMomentumRangeCmd ) {
+    G4double pMin = 0., pMax = 0.;
+    G4String unit;
+    std::istringstream is(newValue);
+    is >> pMin >> pMax >> unit;
+    G4double value = G4UIcommand::ValueOf(unit);
+    generator->SetMomentumRange(pMin*value, pMax*value);
+  }
+  else if( command == fMaxZenithCmd ) {
+    generator->SetMaxZenith(fMaxZenithCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fChargeRatioCmd ) {
+    generator->SetChargeRatio(fChargeRatioCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fPlaneHalfWidthCmd ) {
+    generator->SetPlaneHalfWidth(fPlaneHalfWidthCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fInputFileCmd ) {
+    fPrimaryGeneratorAction->GetEventFileGenerator()->SetFile(newValue);
+  }
+  else if( command == fChunkCmd ) {
+    fPrimaryGeneratorAction->GetEventFileGenerator()
+      ->SetChunk(fChunkCmd->GetNewIntValue(newValue));
+  }
+  else if( command == fIsotropicCmd ) {
+    fPrimaryGeneratorAction->SetIsotropic(fIsotropicCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fConeCmd ) {
+    fPrimaryGeneratorAction->SetConeBias(fConeCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fVetoCmd ) {
+    fPrimaryGeneratorAction->SetVeto(fVetoCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fLLPEnableCmd ) {
+    fPrimaryGeneratorAction->SetLLP(fLLPEnableCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fMassCmd ) {
+    llp->SetMass(fMassCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fLifetimeCmd ) {
+    llp->SetLifetime(fLifetimeCmd->GetNewDoubleValue(newValue));
+  }
+  else if( command == fOriginCmd ) {
+    llp->SetOrigin(fOriginCmd->GetNew3VectorValue(newValue));
+  }
+  else if( command == fDaughtersCmd ) {
+    G4String name1, name2;
+    std::istringstream is(newValue);
+    is >> name1 >> name2;
+    llp->SetDaughters(name1, name2);
+  }
+  else if( command == fSpectrumCmd ) {
+    llp->SetSpectrum(newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
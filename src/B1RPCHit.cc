@@ -0,0 +1,122 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RPCHit.cc
+/// \brief Implementation of the B1RPCHit class
+
+#include "B1RPCHit.hh"
+
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <iomanip>
+
+G4ThreadLocal G4Allocator<B1RPCHit>* B1RPCHitAllocator = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RPCHit::B1RPCHit()
+ : G4VHit(),
+   fType(kRoleOther),
+   fParticleID(0),
+   fTrackID(-1),
+   fParentID(-1),
+   fPrimaryID(-1),
+   fChannelID(0),
+   fEntryPos(),
+   fPos(),
+   fTime(0.),
+   fEnergy(0.),
+   fNofSteps(1)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RPCHit::~B1RPCHit() {}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RPCHit::B1RPCHit(const B1RPCHit& right)
+  : G4VHit()
+{
+  fType        = right.fType;
+  fParticleID  = right.fParticleID;
+  fTrackID     = right.fTrackID;
+  fParentID    = right.fParentID;
+  fPrimaryID   = right.fPrimaryID;
+  fChannelID   = right.fChannelID;
+  fEntryPos    = right.fEntryPos;
+  fPos         = right.fPos;
+  fTime        = right.fTime;
+  fEnergy      = right.fEnergy;
+  fNofSteps    = right.fNofSteps;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const B1RPCHit& B1RPCHit::operator=(const B1RPCHit& right)
+{
+  fType        = right.fType;
+  fParticleID  = right.fParticleID;
+  fTrackID     = right.fTrackID;
+  fParentID    = right.fParentID;
+  fPrimaryID   = right.fPrimaryID;
+  fChannelID   = right.fChannelID;
+  fEntryPos    = right.fEntryPos;
+  fPos         = right.fPos;
+  fTime        = right.fTime;
+  fEnergy      = right.fEnergy;
+  fNofSteps    = right.fNofSteps;
+
+  return *this;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1RPCHit::operator==(const B1RPCHit& right) const
+{
+  return ( this == &right ) ? 1 : 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RPCHit::Print()
+{
+  G4cout
+     << (fType == kRoleGas ? "  gas" : "  plate")
+     << " trackID: " << fTrackID << " particle: " << fParticleID
+     << " channel: " << std::hex << fChannelID << std::dec
+     << (fType == kRoleGas ? " DeltaE: " : " Edep: ")
+     << std::setw(7) << G4BestUnit(fEnergy,"Energy")
+     << " Position: "
+     << std::setw(7) << G4BestUnit( fPos,"Length")
+     << " Time: "
+     << std::setw(7) << G4BestUnit(fTime,"Time")
+     << " Steps: " << fNofSteps
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,281 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RPCSensitiveDetector.cc
+/// \brief Implementation of the B1RPCSensitiveDetector class
+
+#include "B1RPCSensitiveDetector.hh"
+#include "B1DetectorConstruction.hh"
+#include "B1TrackInformation.hh"
+#include "B1RunAction.hh"
+#include "B1ChannelID.hh"
+
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4SDManager.hh"
+#include "G4RunManager.hh"
+#include "G4VTouchable.hh"
+#include "G4VProcess.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RPCSensitiveDetector::B1RPCSensitiveDetector(const G4String& name,
+					       B1VolumeRole role,
+					       const B1DetectorConstruction* detector)
+ : G4VSensitiveDetector(name),
+   fRole(role),
+   fDetector(detector),
+   fPlateDetector(0),
+   fOutputHits(true),
+   fOutputAvalanche(true),
+   fOutputPrimary(true),
+   fAggregate(false),
+   fCurrentTrackID(-1),
+   fCurrentHit(0),
+   fFastTrackID(-1),
+   fHitsCollection(0),
+   fCrossingsCollection(0),
+   fHitsCollectionID(-1),
+   fCrossingsCollectionID(-1)
+{
+  collectionName.insert("Hits");
+  if(fRole == kRoleGas)
+    collectionName.insert("Crossings");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RPCSensitiveDetector::~B1RPCSensitiveDetector()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RPCSensitiveDetector::Initialize(G4HCofThisEvent* hce)
+{
+  // Aggregation and outputs of the booked ntuple columns
+  const B1RunAction* runAction = static_cast<const B1RunAction*>
+    (G4RunManager::GetRunManager()->GetUserRunAction());
+  fAggregate = runAction->aggregateHits;
+  fOutputHits = runAction->GetOutputHits();
+  fOutputAvalanche = runAction->GetOutputAvalanche();
+  fOutputPrimary = runAction->GetOutputPrimary();
+  fCurrentTrackID = -1;
+  fCurrentHit = 0;
+  fFastTrackID = -1;
+
+  // Create hits collections, they are owned by the event
+  fHitsCollection
+    = new B1RPCHitsCollection(SensitiveDetectorName, collectionName[0]);
+  if(fHitsCollectionID < 0)
+    fHitsCollectionID = G4SDManager::GetSDMpointer()->GetCollectionID(fHitsCollection);
+  hce->AddHitsCollection(fHitsCollectionID, fHitsCollection);
+
+  if(fRole == kRoleGas)
+    {
+      fCrossingsCollection
+	= new B1GasCrossingHitsCollection(SensitiveDetectorName, collectionName[1]);
+      if(fCrossingsCollectionID < 0)
+	fCrossingsCollectionID = G4SDManager::GetSDMpointer()->GetCollectionID(fCrossingsCollection);
+      hce->AddHitsCollection(fCrossingsCollectionID, fCrossingsCollection);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1RPCSensitiveDetector::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  G4Track* track = step->GetTrack();
+  auto info = static_cast<const B1TrackInformation*>(track->GetUserInformation());
+  G4bool isGas = (fRole == kRoleGas);
+
+  // The hits and crossings of the fast simulation of the gas are stored by
+  // the model, which leaves the track on the surface of the cell
+  const G4VProcess* process = step->GetPostStepPoint()->GetProcessDefinedStep();
+  if((process && process->GetProcessType() == fParameterisation)
+     || (track->GetTrackID() == fFastTrackID && step->GetStepLength() == 0.))
+    return false;
+
+  // Gas cells record the change in kinetic energy, plates the energy deposit
+  G4double energy = isGas ? step->GetDeltaEnergy() : step->GetTotalEnergyDeposit();
+
+  // A new track, or a track entering a cell, starts a new aggregated hit
+  if(track->GetTrackID() != fCurrentTrackID
+     || step->GetPreStepPoint()->GetStepStatus() == fGeomBoundary)
+    {
+      fCurrentTrackID = track->GetTrackID();
+      fCurrentHit = 0;
+      fEntryPos = step->GetPreStepPoint()->GetPosition();
+    }
+
+  if(fOutputHits && energy != 0)
+    AddHit(track, step->GetPreStepPoint()->GetTouchable(),
+	   step->GetPreStepPoint()->GetPosition(),
+	   step->GetPostStepPoint()->GetPosition(),
+	   step->GetPostStepPoint()->GetGlobalTime(), energy);
+
+  if(!isGas || !step->IsLastStepInVolume())
+    return true;
+
+  // Primary particle leaving the gas, or an electron produced in the gas
+  // that has travelled through it and reached the plate (avalanche)
+  G4bool avalanche = info->IsGasElectron()
+    && step->GetPostStepPoint()->GetSensitiveDetector() == fPlateDetector;
+  AddCrossing(track->GetTrackID(), track->GetParentID(), info->GetPrimaryID(),
+	      track->GetVertexKineticEnergy(), avalanche);
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RPCSensitiveDetector::StartFastCrossing(const G4Track* track,
+					       const G4ThreeVector& entryPos)
+{
+  fFastTrackID = track->GetTrackID();
+  fCurrentTrackID = track->GetTrackID();
+  fCurrentHit = 0;
+  fEntryPos = entryPos;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RPCSensitiveDetector::AddFastHit(const G4Track* track, const G4VTouchable* touchable,
+					const G4ThreeVector& pos, G4double time,
+					G4double energy)
+{
+  if(fOutputHits && energy != 0)
+    AddHit(track, touchable, fEntryPos, pos, time, energy);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RPCSensitiveDetector::AddFastCluster(const G4Track* track, G4int size,
+					    G4double energy)
+{
+  // The cluster electrons are not tracked, their parent is the crossing track.
+  // They are written with the avalanche output, in columns of their own.
+  if(!fOutputAvalanche)
+    return;
+
+  auto info = static_cast<const B1TrackInformation*>(track->GetUserInformation());
+  AddCrossing(-1, track->GetTrackID(), info->GetPrimaryID(), energy, false, size);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RPCSensitiveDetector::AddFastCrossing(const G4Track* track)
+{
+  auto info = static_cast<const B1TrackInformation*>(track->GetUserInformation());
+  AddCrossing(track->GetTrackID(), track->GetParentID(), info->GetPrimaryID(),
+	      track->GetVertexKineticEnergy(), false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RPCSensitiveDetector::AddHit(const G4Track* track, const G4VTouchable* touchable,
+				    const G4ThreeVector& prePos, const G4ThreeVector& pos,
+				    G4double time, G4double energy)
+{
+  if(fAggregate && fCurrentHit)
+    {
+      fCurrentHit->AddStep(pos, energy);
+      return;
+    }
+
+  auto info = static_cast<const B1TrackInformation*>(track->GetUserInformation());
+  B1RPCHit* hit = new B1RPCHit();
+  hit->SetType(fRole);
+  hit->SetParticleID(track->GetDynamicParticle()->GetPDGcode());
+  hit->SetTrackID(track->GetTrackID());
+  hit->SetParentID(track->GetParentID());
+  hit->SetPrimaryID(info->GetPrimaryID());
+  hit->SetChannelID(ChannelID(touchable));
+  hit->SetEntryPos(fAggregate ? fEntryPos : prePos);
+  hit->SetPos(pos);
+  hit->SetTime(time);
+  hit->SetEnergy(energy);
+  fHitsCollection->insert(hit);
+  fCurrentHit = hit;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RPCSensitiveDetector::AddCrossing(G4int trackID, G4int parentID, G4int primaryID,
+					 G4double vertexEnergy, G4bool avalanche,
+					 G4int clusterSize)
+{
+  G4bool primary = fOutputPrimary && (parentID == 0);
+  avalanche = avalanche && fOutputAvalanche;
+  if(!primary && !avalanche && clusterSize == 0)
+    return;
+
+  B1GasCrossingHit* crossing = new B1GasCrossingHit();
+  crossing->SetTrackID(trackID);
+  crossing->SetParentID(parentID);
+  crossing->SetPrimaryID(primaryID);
+  crossing->SetVertexEnergy(vertexEnergy);
+  crossing->SetAvalanche(avalanche);
+  crossing->SetClusterSize(clusterSize);
+  fCrossingsCollection->insert(crossing);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1RPCSensitiveDetector::ChannelID(const G4VTouchable* touchable) const
+{
+  // Faces are placed in the world, groups one level deeper in the centre
+  // volume
+  const G4int kFlatFaceDepth = 2;
+  const G4int kFaceDepth = 5;
+  G4int depth = touchable->GetHistoryDepth();
+
+  // Flat layout: the copy number of the pad is its channel ID in the face
+  // or group
+  if(depth <= kFlatFaceDepth + 1)
+    {
+      G4int station = touchable->GetReplicaNumber(1);
+      if(depth > kFlatFaceDepth)
+	station += B1ChannelID::kNofFaces;
+      return touchable->GetReplicaNumber(0) | B1ChannelID::Encode(station, 0, 0, 0, 0);
+    }
+
+  // Nested layout, depths from the pad: y pad replica, x strip replica, gas
+  // or plate envelope, RPC layer, then the face or group
+  G4int station = touchable->GetReplicaNumber(4);
+  if(depth > kFaceDepth)
+    station += B1ChannelID::kNofFaces;
+
+  G4int cell = B1ChannelID::kGas;
+  if(fRole == kRolePlate)
+    cell = B1ChannelID::kPlate0 + touchable->GetReplicaNumber(2);
+
+  return B1ChannelID::Encode(station, touchable->GetReplicaNumber(3), cell,
+			     touchable->GetReplicaNumber(1),
+			     touchable->GetReplicaNumber(0));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -30,6 +30,8 @@
 #include "B1RunAction.hh"
 #include "B1PrimaryGeneratorAction.hh"
 #include "B1DetectorConstruction.hh"
+#include "B1VolumeRoles.hh"
+#include "B1RunMessenger.hh"
 // #include "B1Run.hh"
 
 #include "G4RunManager.hh"
@@ -44,13 +46,37 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1RunAction::B1RunAction()
-: G4UserRunAction()
-{ }
+: G4UserRunAction(),
+  fNofSteps(0.),
+  fLiveTime(0.),
+  fPrimaryTrials(0.),
+  fPrimaryWeight(0.),
+  fFieldTracks{ {"GasFieldIntegrated", 0}, {"GasFieldCoarse", 0}, {"GasFieldStraight", 0} },
+  fOutputHits(true),
+  fOutputAvalanche(true),
+  fOutputPrimary(true),
+  fOutputPositions(true),
+  fNtupleBooked(false),
+  fOutputFile("output")
+{
+  fMessenger = new B1RunMessenger(this);
+
+  // Register accumulable to the accumulable manager
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fNofSteps);
+  accumulableManager->RegisterAccumulable(fLiveTime);
+  accumulableManager->RegisterAccumulable(fPrimaryTrials);
+  accumulableManager->RegisterAccumulable(fPrimaryWeight);
+  for (G4int i = 0; i < 3; i++)
+    accumulableManager->RegisterAccumulable(fFieldTracks[i]);
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1RunAction::~B1RunAction()
-{}
+{
+  delete fMessenger;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -59,29 +85,102 @@ void B1RunAction::BeginOfRunAction(const G4Run*)
   // inform the runManager to save random number seed
   G4RunManager::GetRunManager()->SetRandomNumberStore(false);
 
-  // Create analysis manager, tree, and output file
+  // Build the volume role table used by the user actions of this thread
+  B1VolumeRoles::Instance()->Build();
+
+  // Field parameters set on the master since the last run (/rpc/field/)
+  const B1DetectorConstruction* detector
+    = static_cast<const B1DetectorConstruction*>
+      (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  detector->ApplyFieldParameters();
+
+  // Reset accumulables to their initial values and start the run timer
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->Reset();
+  fTimer.Start();
+
+  // Create analysis manager, tree, and output file. The tree is booked for
+  // the first run of the thread only, later runs (e.g. after the geometry
+  // has been changed) reopen the file with the same columns and keep the
+  // output selection they were booked with.
   auto *analysisManager = G4RootAnalysisManager::Instance();
   analysisManager->SetVerboseLevel(1);
 
+  if(!fNtupleBooked)
+    {
+      BookNtuple();
+      fNtupleBooked = true;
+    }
+  else
+    KeepBookedOutputs(detector);
+  
+  analysisManager->OpenFile(fOutputFile);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::BookNtuple()
+{
+  auto *analysisManager = G4RootAnalysisManager::Instance();
+
   analysisManager->CreateNtuple("output", "output");
 
-  analysisManager->CreateNtupleDColumn("EnergyDeposition", edep);
-  analysisManager->CreateNtupleDColumn("GasDeltaEnergy", deltaEnergy);
-  analysisManager->CreateNtupleIColumn("ParticleID", particleID);
-  analysisManager->CreateNtupleIColumn("TrackID", trackID);
-  analysisManager->CreateNtupleIColumn("ParentID", parentID);
-  analysisManager->CreateNtupleDColumn("HitPosX", hitPosX);
-  analysisManager->CreateNtupleDColumn("HitPosY", hitPosY);
-  analysisManager->CreateNtupleDColumn("HitPosZ", hitPosZ);
-  analysisManager->CreateNtupleDColumn("Time", time);
-  analysisManager->CreateNtupleDColumn("FinalEnergy", finalEnergy);
-  analysisManager->CreateNtupleIColumn("AvalancheSize", avalancheSize);
-  analysisManager->CreateNtupleDColumn("AvalancheEnergy", avalancheEnergy);
-  analysisManager->CreateNtupleIColumn("LayerCount", layerCount);
+  // Gas and plate hit streams, with the aggregated hit columns if enabled
+  const B1DetectorConstruction* detector
+    = static_cast<const B1DetectorConstruction*>
+      (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  aggregateHits = detector->GetAggregateHits();
+  fBookedOutputs[0] = fOutputHits;
+  fBookedOutputs[1] = fOutputAvalanche;
+  fBookedOutputs[2] = fOutputPrimary;
+  fBookedOutputs[3] = fOutputPositions;
+  if(fOutputHits)
+    {
+      BookHitStream("Gas", "DeltaEnergy", hits.gas);
+      BookHitStream("Plate", "EnergyDeposition", hits.plate);
+    }
+
+  if(fOutputPrimary)
+    analysisManager->CreateNtupleDColumn("FinalEnergy", hits.finalEnergy);
+  if(fOutputAvalanche)
+    {
+      analysisManager->CreateNtupleIColumn("AvalancheSize", hits.avalancheSize);
+      analysisManager->CreateNtupleDColumn("AvalancheEnergy", hits.avalancheEnergy);
+      analysisManager->CreateNtupleIColumn("AvalanchePrimaryID", hits.avalanchePrimaryID);
+      // Primary clusters of the fast simulation, empty with full transport
+      analysisManager->CreateNtupleIColumn("ClusterCount", hits.clusterCount);
+      analysisManager->CreateNtupleIColumn("ClusterSize", hits.clusterSize);
+      analysisManager->CreateNtupleIColumn("ClusterPrimaryID", hits.clusterPrimaryID);
+    }
+  if(fOutputPrimary)
+    analysisManager->CreateNtupleIColumn("LayerCount", hits.layerCount);
+
+  // Importance sampling weight of the primary vertex, 1 without biasing
+  analysisManager->CreateNtupleDColumn("Weight", hits.weight);
 
   analysisManager->FinishNtuple();
-  
-  analysisManager->OpenFile("output");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::KeepBookedOutputs(const B1DetectorConstruction* detector)
+{
+  // The columns cannot be booked again, so the selection of the booking
+  // is restored, and the readout uses the aggregation it was booked with
+  if(fOutputHits == fBookedOutputs[0] && fOutputAvalanche == fBookedOutputs[1]
+     && fOutputPrimary == fBookedOutputs[2] && fOutputPositions == fBookedOutputs[3]
+     && detector->GetAggregateHits() == aggregateHits)
+    return;
+
+  if(IsMaster())
+    G4Exception("B1RunAction::BeginOfRunAction()", "B1Output001", JustWarning,
+		"The ntuple columns are booked at the first run, the changes of"
+		" /rpc/output/hits|avalanche|primary|positions and"
+		" /rpc/readout/aggregate since are ignored");
+  fOutputHits = fBookedOutputs[0];
+  fOutputAvalanche = fBookedOutputs[1];
+  fOutputPrimary = fBookedOutputs[2];
+  fOutputPositions = fBookedOutputs[3];
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -91,6 +190,14 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
   G4int nofEvents = run->GetNumberOfEvent();
   if (nofEvents == 0) return;
 
+  // Stop the timer and merge accumulables
+  fTimer.Stop();
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->Merge();
+
+  G4double nofSteps = fNofSteps.GetValue();
+  G4double realTime = fTimer.GetRealElapsed();
+
   // Get analysis manager and close output
   auto *analysisManager = G4RootAnalysisManager::Instance();
   analysisManager->Write();
@@ -104,13 +211,7 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
      (G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction());
   G4String runCondition;
   if (generatorAction)
-  {
-    const G4ParticleGun* particleGun = generatorAction->GetParticleGun();
-    runCondition += particleGun->GetParticleDefinition()->GetParticleName();
-    runCondition += " of ";
-    G4double particleEnergy = particleGun->GetParticleEnergy();
-    runCondition += G4BestUnit(particleEnergy,"Energy");
-  }
+    runCondition = generatorAction->GetDescription();
         
   // Print
   //  
@@ -125,9 +226,61 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
      << "--------------------End of Local Run------------------------";
   }
   
+  // Field of the run, to tell the points of a scan apart in the log
+  const B1DetectorConstruction* detector
+    = static_cast<const B1DetectorConstruction*>
+      (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  const B1FieldParameters& field = detector->GetFieldParameters();
+
   G4cout
      << G4endl
      << " The run consists of " << nofEvents << " "<< runCondition
+     << G4endl
+     << " Gas field: " << field.fieldValue/(kilovolt/cm) << " kV/cm";
+  if (!field.fieldMap.empty())
+    G4cout << " outside the map " << field.fieldMap;
+  G4cout
+     << ", output " << fOutputFile
+     << G4endl
+     << " Steps taken: " << nofSteps << " in " << realTime << " s";
+  if (realTime > 0.)
+    G4cout << " (" << nofSteps/realTime << " steps/s)";
+
+  // Tracks through the gas field per propagation mode (B1GasFieldManager)
+  G4int nofFieldTracks[3];
+  for (G4int i = 0; i < 3; i++)
+    nofFieldTracks[i] = fFieldTracks[i].GetValue();
+  // Equivalent exposure of the cosmic muons (B1CosmicMuonGenerator), the
+  // rate counts the weighted events
+  G4double liveTime = fLiveTime.GetValue();
+  G4double sumOfWeights = fPrimaryWeight.GetValue();
+  if (liveTime > 0.)
+    G4cout
+       << G4endl
+       << " Cosmic muon live time: " << G4BestUnit(liveTime, "Time")
+       << " (" << sumOfWeights/(liveTime/s) << " muons/s)";
+
+  // Primaries thrown away before transport by the acceptance veto, and
+  // the weighted fraction of them in the events (e.g. the long-lived
+  // particles decaying in the centre volume, B1LLPGenerator)
+  G4double nofTrials = fPrimaryTrials.GetValue();
+  if (nofTrials > nofEvents)
+    G4cout
+       << G4endl
+       << " Primaries generated: " << nofTrials << ", "
+       << 100.*nofEvents/nofTrials << " % within the acceptance";
+  if (nofTrials > 0. && sumOfWeights != nofEvents)
+    G4cout
+       << G4endl
+       << " Sum of the weights: " << sumOfWeights << ", "
+       << sumOfWeights/nofTrials << " per generated primary";
+
+  if (nofFieldTracks[0] + nofFieldTracks[1] + nofFieldTracks[2] > 0)
+    G4cout
+       << G4endl
+       << " Gas field tracks: " << nofFieldTracks[0] << " integrated, "
+       << nofFieldTracks[1] << " coarse, " << nofFieldTracks[2] << " straight";
+  G4cout
      << G4endl
      << "------------------------------------------------------------"
      << G4endl
@@ -136,3 +289,33 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void B1RunAction::BookHitStream(const G4String& prefix, const G4String& energyName,
+				B1HitBuffer::Stream& stream)
+{
+  auto *analysisManager = G4RootAnalysisManager::Instance();
+
+  analysisManager->CreateNtupleIColumn(prefix + "ParticleID", stream.particleID);
+  analysisManager->CreateNtupleIColumn(prefix + "TrackID", stream.trackID);
+  analysisManager->CreateNtupleIColumn(prefix + "ParentID", stream.parentID);
+  analysisManager->CreateNtupleIColumn(prefix + "PrimaryID", stream.primaryID);
+  analysisManager->CreateNtupleIColumn(prefix + "ChannelID", stream.channelID);
+  if(fOutputPositions)
+    {
+      analysisManager->CreateNtupleDColumn(prefix + "HitPosX", stream.hitPosX);
+      analysisManager->CreateNtupleDColumn(prefix + "HitPosY", stream.hitPosY);
+      analysisManager->CreateNtupleDColumn(prefix + "HitPosZ", stream.hitPosZ);
+    }
+  analysisManager->CreateNtupleDColumn(prefix + "Time", stream.time);
+  analysisManager->CreateNtupleDColumn(prefix + energyName, stream.energy);
+
+  // Entry positions and step counts of aggregated hits
+  if(aggregateHits)
+    {
+      analysisManager->CreateNtupleDColumn(prefix + "HitEntryPosX", stream.hitEntryPosX);
+      analysisManager->CreateNtupleDColumn(prefix + "HitEntryPosY", stream.hitEntryPosY);
+      analysisManager->CreateNtupleDColumn(prefix + "HitEntryPosZ", stream.hitEntryPosZ);
+      analysisManager->CreateNtupleIColumn(prefix + "HitSteps", stream.hitSteps);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,109 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RunMessenger.cc
+/// \brief Implementation of the B1RunMessenger class
+
+#include "B1RunMessenger.hh"
+#include "B1RunAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RunMessenger::B1RunMessenger(B1RunAction* runAction)
+ : G4UImessenger(),
+   fRunAction(runAction)
+{
+  fOutputDirectory = new G4UIdirectory("/rpc/output/");
+  fOutputDirectory->SetGuidance("Selection of the ntuple outputs");
+  fOutputDirectory->SetGuidance("The ntuple columns are booked at the first run, later");
+  fOutputDirectory->SetGuidance("changes of the selection are ignored with a warning.");
+
+  fHitsCmd = new G4UIcmdWithABool("/rpc/output/hits",this);
+  fHitsCmd->SetGuidance("Write the gas and plate hits.");
+  fHitsCmd->SetParameterName("hits",false);
+  fHitsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fAvalancheCmd = new G4UIcmdWithABool("/rpc/output/avalanche",this);
+  fAvalancheCmd->SetGuidance("Write the avalanche size and electron energies.");
+  fAvalancheCmd->SetParameterName("avalanche",false);
+  fAvalancheCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPrimaryCmd = new G4UIcmdWithABool("/rpc/output/primary",this);
+  fPrimaryCmd->SetGuidance("Write the final energy and layer count of the primary.");
+  fPrimaryCmd->SetGuidance("When hits and avalanche outputs are both off, only the");
+  fPrimaryCmd->SetGuidance("primary is tracked and all secondaries are killed.");
+  fPrimaryCmd->SetParameterName("primary",false);
+  fPrimaryCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPositionsCmd = new G4UIcmdWithABool("/rpc/output/positions",this);
+  fPositionsCmd->SetGuidance("Write the hit positions next to the channel IDs.");
+  fPositionsCmd->SetParameterName("positions",false);
+  fPositionsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fFileCmd = new G4UIcmdWithAString("/rpc/output/file",this);
+  fFileCmd->SetGuidance("Name of the output file of the next run (default output).");
+  fFileCmd->SetParameterName("fileName",false);
+  fFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RunMessenger::~B1RunMessenger()
+{
+  delete fHitsCmd;
+  delete fAvalancheCmd;
+  delete fPrimaryCmd;
+  delete fPositionsCmd;
+  delete fFileCmd;
+  delete fOutputDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if( command == fHitsCmd ) {
+    fRunAction->SetOutputHits(fHitsCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fAvalancheCmd ) {
+    fRunAction->SetOutputAvalanche(fAvalancheCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fPrimaryCmd ) {
+    fRunAction->SetOutputPrimary(fPrimaryCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fPositionsCmd ) {
+    fRunAction->SetOutputPositions(fPositionsCmd->GetNewBoolValue(newValue));
+  }
+  else if( command == fFileCmd ) {
+    fRunAction->SetOutputFile(newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
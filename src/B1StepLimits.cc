@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepLimits.cc
+/// \brief Implementation of the B1StepLimits class
+
+#include "B1StepLimits.hh"
+
+#include "G4Track.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepLimits::B1StepLimits(const G4String& type)
+  : G4UserLimits(type)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepLimits::~B1StepLimits()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepLimits::SetMaxAllowedStep(const G4ParticleDefinition* particle,
+				     G4double maxStep)
+{
+  for(auto& limit : fParticleMaxSteps)
+    {
+      if(limit.first == particle)
+	{
+	  limit.second = maxStep;
+	  return;
+	}
+    }
+  fParticleMaxSteps.push_back(std::make_pair(particle, maxStep));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1StepLimits::GetMaxAllowedStep(const G4Track& track)
+{
+  // Only a few particles have their own limit
+  const G4ParticleDefinition* particle = track.GetDefinition();
+  for(const auto& limit : fParticleMaxSteps)
+    {
+      if(limit.first == particle)
+	return limit.second;
+    }
+  return fMaxStep;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,103 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackingAction.cc
+/// \brief Implementation of the B1TrackingAction class
+
+#include "B1TrackingAction.hh"
+#include "B1RunAction.hh"
+#include "B1EventAction.hh"
+#include "B1TrackInformation.hh"
+
+#include "G4Track.hh"
+#include "G4TrackingManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackingAction::B1TrackingAction(B1RunAction* runAction,
+				   B1EventAction* eventAction)
+: G4UserTrackingAction(),
+  fVolumeRoles(B1VolumeRoles::Instance()),
+  fRunAction(runAction),
+  fEventAction(eventAction)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackingAction::~B1TrackingAction()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackingAction::PreUserTrackingAction(const G4Track* track)
+{
+  // Secondaries were given their information by their parent
+  if(track->GetUserInformation())
+    return;
+
+  // Primary particle, its touchable is only known if it has been located
+  B1VolumeRole originRole = kRoleOther;
+  G4VPhysicalVolume* volume = track->GetVolume();
+  if(volume)
+    originRole = fVolumeRoles->GetRole(volume->GetLogicalVolume());
+  G4bool electron = (track->GetDynamicParticle()->GetPDGcode() == 11);
+  track->SetUserInformation(new B1TrackInformation(originRole, 0,
+						   track->GetTrackID(), electron));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  fRunAction->AddSteps(track->GetCurrentStepNumber());
+
+  // Pass the generation and primary ancestor on to the secondaries, whose
+  // touchable is the volume they were produced in. In primary only mode the
+  // secondaries are killed by the stacking action and need no information.
+  G4TrackVector* secondaries = fpTrackingManager->GimmeSecondaries();
+  if(secondaries && !secondaries->empty() && !fRunAction->IsPrimaryOnly())
+    {
+      auto info = static_cast<const B1TrackInformation*>(track->GetUserInformation());
+      G4int generation = info->GetGeneration() + 1;
+      G4int primaryID = info->GetPrimaryID();
+      for(auto secondary : *secondaries)
+	{
+	  B1VolumeRole originRole
+	    = fVolumeRoles->GetRole(secondary->GetVolume()->GetLogicalVolume());
+	  G4bool electron = (secondary->GetDynamicParticle()->GetPDGcode() == 11);
+	  secondary->SetUserInformation(new B1TrackInformation(originRole, generation,
+							       primaryID, electron));
+	}
+    }
+
+  // Final energy of the primary particle, relative to its initial energy
+  if(track->GetParentID() == 0)
+    fEventAction->FinalEnergy(track->GetKineticEnergy()/track->GetVertexKineticEnergy());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,263 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//
+//
+/// \file B1UniformElectricStepper.cc
+/// \brief Implementation of the B1UniformElectricStepper class
+
+#include "B1UniformElectricStepper.hh"
+#include "B1EqElectricField.hh"
+
+#include "G4Field.hh"
+#include "G4PhysicalConstants.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+  // Relative precision of the path length of a step
+  const G4double kPrecision = 1e-12;
+  const G4int kMaxIterations = 50;
+  const G4int kMaxDepth = 16;
+  // Relative change of |p| over an interval integrated without subdivision
+  const G4double kSmoothVariation = 1e-3;
+
+  // Four point Gauss-Legendre rule on [-1, 1]
+  const G4double kNodes[4] = { -0.861136311594052575, -0.339981043584856265,
+			       0.339981043584856265, 0.861136311594052575 };
+  const G4double kWeights[4] = { 0.347854845137453857, 0.652145154862546143,
+				 0.652145154862546143, 0.347854845137453857 };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1UniformElectricStepper::B1UniformElectricStepper(B1EqElectricField* equation,
+						   G4int nvar)
+  : G4MagIntegratorStepper(equation, nvar),
+    fEquation(equation),
+    fForce(0.),
+    fMomT2(0.),
+    fEnergyT(0.),
+    fSinh0(0.),
+    fCosh0(1.)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1UniformElectricStepper::~B1UniformElectricStepper()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1UniformElectricStepper::Stepper(const G4double y[], const G4double[],
+				       G4double h, G4double yout[], G4double yerr[])
+{
+  const G4int nvar = GetNumberOfVariables();
+  for(G4int i=0; i<nvar; i++)
+    {
+      yout[i] = y[i];
+      yerr[i] = 0.;
+    }
+
+  G4ThreeVector position(y[0], y[1], y[2]);
+  G4ThreeVector momentum(y[3], y[4], y[5]);
+  G4double mass = fEquation->GetMass();
+  G4double mom = momentum.mag();
+
+  // Force on the particle, in MeV/mm
+  G4double point[4] = { y[0], y[1], y[2], y[7] };
+  G4double field[6] = { 0., 0., 0., 0., 0., 0. };
+  const G4Field* fieldObj = fEquation->GetFieldObj();
+  if(fieldObj)
+    fieldObj->GetFieldValue(point, field);
+  G4ThreeVector force = fEquation->GetCharge()*eplus
+    *G4ThreeVector(field[3], field[4], field[5]);
+  fForce = force.mag();
+  fStartPoint = position;
+
+  if(fForce == 0.)
+    {
+      // Straight line
+      G4ThreeVector direction = momentum.unit();
+      fMidPoint = position + 0.5*h*direction;
+      fEndPoint = position + h*direction;
+      yout[0] = fEndPoint.x(); yout[1] = fEndPoint.y(); yout[2] = fEndPoint.z();
+      if(mom > 0.)
+	yout[7] = y[7] + h*std::sqrt(mom*mom + mass*mass)/(mom*c_light);
+      return;
+    }
+
+  fForceDir = force/fForce;
+  G4double momPar = momentum.dot(fForceDir);
+  fMomT = momentum - momPar*fForceDir;
+  fMomT2 = fMomT.mag2();
+  fEnergyT = std::sqrt(mass*mass + fMomT2);
+  fSinh0 = momPar/fEnergyT;
+  fCosh0 = std::sqrt(1. + fSinh0*fSinh0);
+
+  // Solve s(deta) = h, starting from |p| linear in eta over the step, which
+  // is already precise for fast particles. The Newton steps are kept inside
+  // the bracket of the solution, and only the path length between
+  // successive estimates is integrated.
+  G4double target = h*fForce; // Integral of |p| over the step
+  G4double tolerance = kPrecision*target;
+  G4double deta;
+  if(mom > 0.)
+    {
+      G4double slope = momPar*fEnergyT*fCosh0/mom; // d|p|/d(eta)
+      G4double discriminant = mom*mom + 2.*slope*target;
+      deta = discriminant > 0. ?
+	2.*target/(mom + std::sqrt(discriminant)) : target/mom;
+    }
+  else
+    deta = std::acosh(1. + target/fEnergyT); // From rest
+  G4double integral = Integral(0., deta);
+  G4double low = 0., high = DBL_MAX;
+  for(G4int i=0; i<kMaxIterations; i++)
+    {
+      G4double residual = integral - target;
+      if(std::fabs(residual) <= tolerance)
+	break;
+      if(residual > 0.)
+	high = std::min(high, deta);
+      else
+	low = std::max(low, deta);
+
+      G4double next = deta - residual/Momentum(deta);
+      if(!(next > low && next < high))
+	next = high < DBL_MAX ? 0.5*(low + high) : 2.*deta;
+      integral += Integral(deta, next);
+      deta = next;
+    }
+
+  fMidPoint = position + Displacement(0.5*deta);
+  fEndPoint = position + Displacement(deta);
+
+  G4double momPar1 = fEnergyT*(fSinh0*std::cosh(deta) + fCosh0*std::sinh(deta));
+  G4ThreeVector momentum1 = fMomT + momPar1*fForceDir;
+
+  // c t = E_T/F (sinh(eta1) - sinh(eta0)) = 2 E_T/F cosh(eta_mid) sinh(deta/2)
+  G4double halfSinh = std::sinh(0.5*deta);
+  G4double coshMid = fCosh0*std::cosh(0.5*deta) + fSinh0*halfSinh;
+  G4double cTime = 2.*fEnergyT/fForce*coshMid*halfSinh;
+
+  yout[0] = fEndPoint.x(); yout[1] = fEndPoint.y(); yout[2] = fEndPoint.z();
+  yout[3] = momentum1.x(); yout[4] = momentum1.y(); yout[5] = momentum1.z();
+  yout[7] = y[7] + cTime/c_light;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1UniformElectricStepper::DistChord() const
+{
+  // Distance of the middle of the trajectory from the chord
+  G4ThreeVector chord = fEndPoint - fStartPoint;
+  G4ThreeVector toMid = fMidPoint - fStartPoint;
+  if(chord.mag2() == 0.)
+    return toMid.mag();
+  return toMid.cross(chord).mag()/chord.mag();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1UniformElectricStepper::Momentum(G4double deta) const
+{
+  // sinh and cosh of deta from a single expm1, accurate for small steps
+  G4double u = std::expm1(deta);
+  G4double sinhStep = 0.5*(u + u/(1. + u));
+  G4double coshStep = 1. + 0.5*u*u/(1. + u);
+  G4double momPar = fEnergyT*(fSinh0*coshStep + fCosh0*sinhStep);
+  return std::sqrt(fMomT2 + momPar*momPar);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1UniformElectricStepper::Integral(G4double deta0, G4double deta1) const
+{
+  // Without transverse momentum |p| has a kink where the particle stops
+  // along the force, the integral is split there
+  G4double stop = -std::asinh(fSinh0);
+  if((stop - deta0)*(stop - deta1) < 0.)
+    return Integral(deta0, stop) + Integral(stop, deta1);
+
+  G4double center = 0.5*(deta0 + deta1);
+  G4double halfWidth = 0.5*(deta1 - deta0);
+  G4double whole = 0.;
+  for(G4int i=0; i<4; i++)
+    whole += kWeights[i]*Momentum(center + halfWidth*kNodes[i]);
+  whole *= halfWidth;
+
+  // |p| is monotonic on either side of the stop. If it hardly changes over
+  // the interval, as for all but slow particles, the rule is exact to the
+  // precision; otherwise the interval is subdivided.
+  G4double mom0 = Momentum(deta0);
+  G4double mom1 = Momentum(deta1);
+  G4double maxMom = std::max(mom0, mom1);
+  if(std::fabs(mom1 - mom0) <= kSmoothVariation*maxMom)
+    return whole;
+  G4double tolerance = kPrecision*std::fabs(deta1 - deta0)*maxMom;
+  return AdaptiveIntegral(deta0, deta1, whole, tolerance, kMaxDepth);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1UniformElectricStepper::AdaptiveIntegral(G4double deta0, G4double deta1,
+						    G4double whole, G4double tolerance,
+						    G4int depth) const
+{
+  // Compare the rule on the interval with the sum over its two halves
+  G4double middle = 0.5*(deta0 + deta1);
+  G4double quarter = 0.25*(deta1 - deta0);
+  G4double left = 0., right = 0.;
+  for(G4int i=0; i<4; i++)
+    {
+      left += kWeights[i]*Momentum(0.5*(deta0 + middle) + quarter*kNodes[i]);
+      right += kWeights[i]*Momentum(0.5*(middle + deta1) + quarter*kNodes[i]);
+    }
+  left *= quarter;
+  right *= quarter;
+
+  if(depth == 0 || std::fabs(left + right - whole) <= tolerance)
+    return left + right;
+  return AdaptiveIntegral(deta0, middle, left, 0.5*tolerance, depth - 1)
+    + AdaptiveIntegral(middle, deta1, right, 0.5*tolerance, depth - 1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector B1UniformElectricStepper::Displacement(G4double deta) const
+{
+  // cosh(eta) - cosh(eta0) = 2 sinh(eta_mid) sinh(deta/2), without the
+  // cancellation of the difference for small steps
+  G4double halfSinh = std::sinh(0.5*deta);
+  G4double sinhMid = fSinh0*std::cosh(0.5*deta) + fCosh0*halfSinh;
+  return (2.*fEnergyT/fForce*sinhMid*halfSinh)*fForceDir + (deta/fForce)*fMomT;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
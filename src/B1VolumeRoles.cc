@@ -0,0 +1,88 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1VolumeRoles.cc
+/// \brief Implementation of the B1VolumeRoles class
+
+#include "B1VolumeRoles.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4AutoDelete.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1VolumeRoles* B1VolumeRoles::Instance()
+{
+  static G4ThreadLocal B1VolumeRoles* instance = nullptr;
+  if(!instance)
+    {
+      instance = new B1VolumeRoles();
+      G4AutoDelete::Register(instance);
+    }
+  return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1VolumeRoles::B1VolumeRoles()
+  : fLastVolume(nullptr),
+    fLastRole(kRoleOther)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1VolumeRoles::~B1VolumeRoles()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1VolumeRoles::Build()
+{
+  fTable.clear();
+  fLastVolume = nullptr;
+  fLastRole = kRoleOther;
+
+  // Names are only compared here, once per run
+  G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  for(auto volume : *store)
+    fTable.push_back(std::make_pair(volume, RoleFromName(volume->GetName())));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1VolumeRole B1VolumeRoles::RoleFromName(const G4String& name)
+{
+  // Replicas and their envelopes share the name of the layer they belong to
+  if(name == "Gas") return kRoleGas;
+  if(name == "Plate") return kRolePlate;
+  if(name == "World" || name == "Centre Volume" || name == "Face"
+     || name == "Group" || name == "RPC" || name == "Box")
+    return kRoleEnvelope;
+  return kRoleOther;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,360 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AcceptanceEngine.cc
+/// \brief Implementation of the B1AcceptanceEngine class
+
+#include "B1AcceptanceEngine.hh"
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  const float kNaN = std::numeric_limits<float>::quiet_NaN();
+
+  // Distances along a block of rays to the entry into and exit from a box,
+  // the ray crosses the box if near <= far. Origins inside the box have a
+  // zero entry distance.
+  inline void BoxKernel(const float* ox, const float* oy, const float* oz,
+			const float* ix, const float* iy, const float* iz,
+			std::size_t n, float minX, float minY, float minZ,
+			float maxX, float maxY, float maxZ, float* tNear, float* tFar)
+  {
+#pragma omp simd
+    for(std::size_t r=0; r<n; r++)
+      {
+	float ax = (minX - ox[r])*ix[r], bx = (maxX - ox[r])*ix[r];
+	float ay = (minY - oy[r])*iy[r], by = (maxY - oy[r])*iy[r];
+	float az = (minZ - oz[r])*iz[r], bz = (maxZ - oz[r])*iz[r];
+	tNear[r] = std::max(std::max(std::min(ax, bx), std::min(ay, by)),
+			    std::max(std::min(az, bz), 0.f));
+	tFar[r] = std::min(std::min(std::max(ax, bx), std::max(ay, by)),
+			   std::max(az, bz));
+      }
+  }
+
+  // Crossing of the slabs of a station, which all have the transverse
+  // extent of the station: only the distances along the station axis
+  // differ from those of the station box
+  inline void SlabKernel(const float* o, const float* inv, std::size_t n,
+			 float min, float max, const float* transNear,
+			 const float* transFar, float* tNear, float* tFar)
+  {
+#pragma omp simd
+    for(std::size_t r=0; r<n; r++)
+      {
+	float a = (min - o[r])*inv[r], b = (max - o[r])*inv[r];
+	tNear[r] = std::max(transNear[r], std::min(a, b));
+	tFar[r] = std::min(transFar[r], std::max(a, b));
+      }
+  }
+
+  // Same as BoxKernel for a single ray
+  inline bool BoxDistances(const double p[3], const double inv[3],
+			   const float min[3], const float max[3],
+			   double& tNear, double& tFar)
+  {
+    tNear = 0.;
+    tFar = std::numeric_limits<double>::infinity();
+    for(int i=0; i<3; i++)
+      {
+	double a = (min[i] - p[i])*inv[i], b = (max[i] - p[i])*inv[i];
+	tNear = std::max(tNear, std::min(a, b));
+	tFar = std::min(tFar, std::max(a, b));
+      }
+    return tNear <= tFar;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AcceptanceEngine::B1AcceptanceEngine(const B1RPCLayout& layout)
+  : fSlabs(layout.GasSlabs())
+{
+  for(std::size_t i=0; i<fSlabs.size(); i++)
+    {
+      const B1RPCLayout::Slab& slab = fSlabs[i];
+      bool newStation = (i == 0 || slab.station != fSlabs[i - 1].station);
+      if(newStation)
+	fStationFirst.push_back(i);
+      for(int d=0; d<3; d++)
+	{
+	  fMin[d].push_back(slab.min[d]);
+	  fMax[d].push_back(slab.max[d]);
+	  if(newStation)
+	    {
+	      fStationMin[d].push_back(slab.min[d]);
+	      fStationMax[d].push_back(slab.max[d]);
+	    }
+	  else
+	    {
+	      fStationMin[d].back() = std::min<float>(fStationMin[d].back(), slab.min[d]);
+	      fStationMax[d].back() = std::max<float>(fStationMax[d].back(), slab.max[d]);
+	    }
+	}
+    }
+  fStationFirst.push_back(fSlabs.size());
+
+  // The station axis is the one along which its slabs are stacked
+  for(std::size_t s=0; s+1<fStationFirst.size(); s++)
+    {
+      const B1RPCLayout::Slab& slab = fSlabs[fStationFirst[s]];
+      int axis = 0;
+      for(int d=1; d<3; d++)
+	if(slab.max[d] - slab.min[d] < slab.max[axis] - slab.min[axis])
+	  axis = d;
+      fStationAxis.push_back(axis);
+    }
+
+  for(int d=0; d<3; d++)
+    fInv[d].resize(kBlock);
+  fNear.resize(kBlock);
+  fFar.resize(kBlock);
+  fTransNear.resize(kBlock);
+  fTransFar.resize(kBlock);
+  fHit.resize(kBlock);
+  fBlockMasks.resize(NofMaskWords()*kBlock);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AcceptanceEngine::~B1AcceptanceEngine()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AcceptanceEngine::Propagate(const Rays& rays, uint64_t* masks,
+				   float* posX, float* posY, float* posZ)
+{
+  for(std::size_t first=0; first<rays.n; first+=kBlock)
+    PropagateBlock(rays, first, std::min(kBlock, rays.n - first),
+		   masks, posX, posY, posZ);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AcceptanceEngine::PropagateBlock(const Rays& rays, std::size_t first, std::size_t n,
+					uint64_t* masks, float* posX, float* posY, float* posZ)
+{
+  const float* ox = rays.x + first;
+  const float* oy = rays.y + first;
+  const float* oz = rays.z + first;
+  const float* dx = rays.dx + first;
+  const float* dy = rays.dy + first;
+  const float* dz = rays.dz + first;
+  float* ix = fInv[0].data();
+  float* iy = fInv[1].data();
+  float* iz = fInv[2].data();
+  float* tNear = fNear.data();
+  float* tFar = fFar.data();
+  unsigned int nWords = NofMaskWords();
+
+#pragma omp simd
+  for(std::size_t r=0; r<n; r++)
+    {
+      ix[r] = 1.f/dx[r];
+      iy[r] = 1.f/dy[r];
+      iz[r] = 1.f/dz[r];
+    }
+  std::fill(fBlockMasks.begin(), fBlockMasks.end(), 0);
+
+  const float* o[3] = { ox, oy, oz };
+  const float* inv[3] = { ix, iy, iz };
+  float* transNear = fTransNear.data();
+  float* transFar = fTransFar.data();
+
+  for(std::size_t s=0; s+1<fStationFirst.size(); s++)
+    {
+      // Distances to the station box without its extent along the axis,
+      // common to all its slabs
+      int axis = fStationAxis[s];
+      float big = std::numeric_limits<float>::max();
+      float min[3] = { fStationMin[0][s], fStationMin[1][s], fStationMin[2][s] };
+      float max[3] = { fStationMax[0][s], fStationMax[1][s], fStationMax[2][s] };
+      min[axis] = -big;
+      max[axis] = big;
+      BoxKernel(ox, oy, oz, ix, iy, iz, n, min[0], min[1], min[2],
+		max[0], max[1], max[2], transNear, transFar);
+
+      // Skip the slabs of a station that no ray of the block crosses
+      SlabKernel(o[axis], inv[axis], n, fStationMin[axis][s], fStationMax[axis][s],
+		 transNear, transFar, tNear, tFar);
+      int any = 0;
+#pragma omp simd reduction(|:any)
+      for(std::size_t r=0; r<n; r++)
+	any |= int(tNear[r] <= tFar[r]);
+
+      for(unsigned int i=fStationFirst[s]; i<fStationFirst[s + 1]; i++)
+	{
+	  float* px = posX ? posX + std::size_t(i)*rays.n + first : nullptr;
+	  float* py = posY ? posY + std::size_t(i)*rays.n + first : nullptr;
+	  float* pz = posZ ? posZ + std::size_t(i)*rays.n + first : nullptr;
+	  if(!any)
+	    {
+	      if(px)
+		{
+		  std::fill(px, px + n, kNaN);
+		  std::fill(py, py + n, kNaN);
+		  std::fill(pz, pz + n, kNaN);
+		}
+	      continue;
+	    }
+
+	  SlabKernel(o[axis], inv[axis], n, fMin[axis][i], fMax[axis][i],
+		     transNear, transFar, tNear, tFar);
+	  uint64_t* m = fBlockMasks.data() + (i/64)*kBlock;
+	  unsigned int bit = i%64;
+#pragma omp simd
+	  for(std::size_t r=0; r<n; r++)
+	    m[r] |= uint64_t(tNear[r] <= tFar[r]) << bit;
+
+	  if(px)
+	    {
+#pragma omp simd
+	      for(std::size_t r=0; r<n; r++)
+		{
+		  bool hit = tNear[r] <= tFar[r];
+		  float t = 0.5f*(tNear[r] + tFar[r]);
+		  px[r] = hit ? ox[r] + t*dx[r] : kNaN;
+		  py[r] = hit ? oy[r] + t*dy[r] : kNaN;
+		  pz[r] = hit ? oz[r] + t*dz[r] : kNaN;
+		}
+	    }
+	}
+    }
+
+  if(nWords == 1)
+    std::copy(fBlockMasks.begin(), fBlockMasks.begin() + n, masks + first);
+  else
+    for(std::size_t r=0; r<n; r++)
+      for(unsigned int w=0; w<nWords; w++)
+	masks[(first + r)*nWords + w] = fBlockMasks[w*kBlock + r];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AcceptanceEngine::PropagateScattered(const Rays& rays, float theta0, std::mt19937& rng,
+					    uint64_t* masks, float* posX, float* posY,
+					    float* posZ)
+{
+  std::normal_distribution<double> gauss(0., theta0);
+  unsigned int nWords = NofMaskWords();
+  std::size_t nStations = fStationFirst.size() - 1;
+  std::vector<uint8_t> visited(nStations);
+
+  for(std::size_t r=0; r<rays.n; r++)
+    {
+      double p[3] = { rays.x[r], rays.y[r], rays.z[r] };
+      double d[3] = { rays.dx[r], rays.dy[r], rays.dz[r] };
+      uint64_t* mask = masks + r*nWords;
+      std::fill(mask, mask + nWords, 0);
+      if(posX)
+	for(unsigned int i=0; i<fSlabs.size(); i++)
+	  posX[i*rays.n + r] = posY[i*rays.n + r] = posZ[i*rays.n + r] = kNaN;
+      std::fill(visited.begin(), visited.end(), 0);
+
+      while(true)
+	{
+	  double inv[3] = { 1./d[0], 1./d[1], 1./d[2] };
+
+	  // Next station along the ray
+	  std::size_t next = nStations;
+	  double nextNear = std::numeric_limits<double>::infinity(), nextFar = 0.;
+	  for(std::size_t s=0; s<nStations; s++)
+	    {
+	      if(visited[s])
+		continue;
+	      float min[3] = { fStationMin[0][s], fStationMin[1][s], fStationMin[2][s] };
+	      float max[3] = { fStationMax[0][s], fStationMax[1][s], fStationMax[2][s] };
+	      double tNear, tFar;
+	      if(BoxDistances(p, inv, min, max, tNear, tFar) && tNear < nextNear)
+		{
+		  next = s;
+		  nextNear = tNear;
+		  nextFar = tFar;
+		}
+	    }
+	  if(next == nStations)
+	    break;
+	  visited[next] = 1;
+
+	  for(unsigned int i=fStationFirst[next]; i<fStationFirst[next + 1]; i++)
+	    {
+	      float min[3] = { fMin[0][i], fMin[1][i], fMin[2][i] };
+	      float max[3] = { fMax[0][i], fMax[1][i], fMax[2][i] };
+	      double tNear, tFar;
+	      if(!BoxDistances(p, inv, min, max, tNear, tFar))
+		continue;
+	      mask[i/64] |= uint64_t(1) << (i%64);
+	      if(posX)
+		{
+		  double t = 0.5*(tNear + tFar);
+		  posX[i*rays.n + r] = p[0] + t*d[0];
+		  posY[i*rays.n + r] = p[1] + t*d[1];
+		  posZ[i*rays.n + r] = p[2] + t*d[2];
+		}
+	    }
+
+	  // Kink at the exit of the station, in two directions perpendicular
+	  // to the ray
+	  for(int i=0; i<3; i++)
+	    p[i] += nextFar*d[i];
+	  if(theta0 > 0.)
+	    {
+	      double u[3];
+	      if(std::fabs(d[0]) < 0.9)
+		{ u[0] = 0.; u[1] = d[2]; u[2] = -d[1]; }
+	      else
+		{ u[0] = -d[2]; u[1] = 0.; u[2] = d[0]; }
+	      double norm = std::sqrt(u[0]*u[0] + u[1]*u[1] + u[2]*u[2]);
+	      for(int i=0; i<3; i++)
+		u[i] /= norm;
+	      double v[3] = { d[1]*u[2] - d[2]*u[1], d[2]*u[0] - d[0]*u[2], d[0]*u[1] - d[1]*u[0] };
+	      double a = gauss(rng), b = gauss(rng);
+	      for(int i=0; i<3; i++)
+		d[i] += a*u[i] + b*v[i];
+	      norm = std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+	      for(int i=0; i<3; i++)
+		d[i] /= norm;
+	    }
+	}
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+unsigned int B1AcceptanceEngine::CountLayers(const uint64_t* mask, unsigned int nWords)
+{
+  unsigned int n = 0;
+  for(unsigned int w=0; w<nWords; w++)
+    n += std::bitset<64>(mask[w]).count();
+  return n;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
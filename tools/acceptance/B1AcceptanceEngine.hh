@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AcceptanceEngine.hh
+/// \brief Definition of the B1AcceptanceEngine class
+
+#ifndef B1AcceptanceEngine_h
+#define B1AcceptanceEngine_h 1
+
+#include "B1RPCLayout.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/// Standalone acceptance engine for the RPC layers of the CODEX-b cube
+///
+/// Intersects batches of rays with the gas gaps of all layers, the slabs of
+/// B1RPCLayout, without Geant4. The rays are given as arrays of origins and
+/// unit directions (structure of arrays) and only travel forwards. For each
+/// ray the engine returns a crossing mask, bit i set if the ray crosses
+/// slab i, in NofMaskWords() 64-bit words, and optionally the midpoints of
+/// the crossings (NaN where the slab is not crossed).
+///
+/// Straight rays go through branch free ray-box kernels over blocks of
+/// rays, which the compiler vectorises. The slabs of a station share its
+/// transverse extent, so the distances to the station box across its axis
+/// are computed once and each slab only adds its interval along the axis;
+/// the slabs are only tested if a ray of the block crosses the station.
+/// Lightly scattered rays are given a Gaussian kink of rms theta0 in each
+/// projection when leaving each station, the stations being crossed in
+/// order along the ray.
+///
+/// The engine keeps work buffers, use one engine per thread.
+
+class B1AcceptanceEngine
+{
+  public:
+    B1AcceptanceEngine(const B1RPCLayout& layout);
+    ~B1AcceptanceEngine();
+
+    struct Rays
+    {
+      const float *x, *y, *z;
+      const float *dx, *dy, *dz;
+      std::size_t n;
+    };
+
+    unsigned int NofSlabs() const { return fSlabs.size(); }
+    unsigned int NofMaskWords() const { return (fSlabs.size() + 63)/64; }
+    const B1RPCLayout::Slab& GetSlab(unsigned int i) const { return fSlabs[i]; }
+
+    // masks[ray*NofMaskWords() + word], positions posX[slab*rays.n + ray]
+    void Propagate(const Rays& rays, uint64_t* masks, float* posX = nullptr,
+		   float* posY = nullptr, float* posZ = nullptr);
+    void PropagateScattered(const Rays& rays, float theta0, std::mt19937& rng,
+			    uint64_t* masks, float* posX = nullptr,
+			    float* posY = nullptr, float* posZ = nullptr);
+
+    static unsigned int CountLayers(const uint64_t* mask, unsigned int nWords);
+
+  private:
+    static const std::size_t kBlock = 256;
+
+    void PropagateBlock(const Rays& rays, std::size_t first, std::size_t n,
+			uint64_t* masks, float* posX, float* posY, float* posZ);
+
+    std::vector<B1RPCLayout::Slab> fSlabs;
+
+    // Slab boxes, and the boxes and first slabs of the stations
+    std::vector<float> fMin[3], fMax[3];
+    std::vector<float> fStationMin[3], fStationMax[3];
+    std::vector<unsigned int> fStationFirst;
+    std::vector<int> fStationAxis;
+
+    // Work buffers of a block of rays
+    std::vector<float> fInv[3];
+    std::vector<float> fNear, fFar;
+    std::vector<float> fTransNear, fTransFar;
+    std::vector<uint8_t> fHit;
+    std::vector<uint64_t> fBlockMasks;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
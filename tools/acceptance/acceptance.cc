@@ -0,0 +1,196 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file acceptance.cc
+/// \brief Main program of the standalone acceptance engine
+
+#include "B1AcceptanceEngine.hh"
+#include "B1RPCLayout.hh"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+  void Usage()
+  {
+    std::cerr
+      << "Usage: acceptance [options]\n"
+      << "  -m model        codexb (default) or demonstrator layout\n"
+      << "  -l file         layout written by /rpc/geometry/writeLayout\n"
+      << "  -n rays         number of rays (default 10000000)\n"
+      << "  -o x y z        origin in mm (default 0 0 -7000, the particle gun)\n"
+      << "  -d dx dy dz     direction (default 0 0 1)\n"
+      << "  -c angle        half angle in rad of a cone around the direction (default 0)\n"
+      << "  -s theta0       rms kink in rad at each station, scattered rays\n"
+      << "  -p              also compute the crossing positions\n"
+      << "  -seed n         random seed\n";
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  B1RPCLayout layout = B1RPCLayout::Model("codexb");
+  long nRays = 10000000;
+  double origin[3] = { 0., 0., -7000. };
+  double axis[3] = { 0., 0., 1. };
+  double cone = 0.;
+  double theta0 = 0.;
+  bool positions = false;
+  unsigned int seed = 12345;
+
+  for(int i=1; i<argc; i++)
+    {
+      std::string arg = argv[i];
+      int nValues = (arg == "-o" || arg == "-d") ? 3 : (arg == "-p" ? 0 : 1);
+      if(i + nValues >= argc)
+	{
+	  Usage();
+	  return 1;
+	}
+      if(arg == "-m")
+	layout = B1RPCLayout::Model(argv[++i]);
+      else if(arg == "-l")
+	{
+	  std::ifstream file(argv[++i]);
+	  if(!file || !layout.Read(file))
+	    {
+	      std::cerr << "Cannot read the layout file " << argv[i] << std::endl;
+	      return 1;
+	    }
+	}
+      else if(arg == "-n")
+	nRays = std::atol(argv[++i]);
+      else if(arg == "-o")
+	for(int j=0; j<3; j++)
+	  origin[j] = std::atof(argv[++i]);
+      else if(arg == "-d")
+	for(int j=0; j<3; j++)
+	  axis[j] = std::atof(argv[++i]);
+      else if(arg == "-c")
+	cone = std::atof(argv[++i]);
+      else if(arg == "-s")
+	theta0 = std::atof(argv[++i]);
+      else if(arg == "-p")
+	positions = true;
+      else if(arg == "-seed")
+	seed = std::atoi(argv[++i]);
+      else
+	{
+	  Usage();
+	  return 1;
+	}
+    }
+
+  B1AcceptanceEngine engine(layout);
+  unsigned int nSlabs = engine.NofSlabs();
+  unsigned int nWords = engine.NofMaskWords();
+
+  // Frame around the cone axis
+  double norm = std::sqrt(axis[0]*axis[0] + axis[1]*axis[1] + axis[2]*axis[2]);
+  double w[3] = { axis[0]/norm, axis[1]/norm, axis[2]/norm };
+  double u[3] = { 0., w[2], -w[1] };
+  if(std::fabs(w[0]) > 0.9)
+    { u[0] = -w[2]; u[1] = 0.; u[2] = w[0]; }
+  norm = std::sqrt(u[0]*u[0] + u[1]*u[1] + u[2]*u[2]);
+  for(int j=0; j<3; j++)
+    u[j] /= norm;
+  double v[3] = { w[1]*u[2] - w[2]*u[1], w[2]*u[0] - w[0]*u[2], w[0]*u[1] - w[1]*u[0] };
+
+  // Rays are generated and propagated in batches, only the propagation is timed
+  const long kBatch = 1 << 16;
+  std::vector<float> x(kBatch, origin[0]), y(kBatch, origin[1]), z(kBatch, origin[2]);
+  std::vector<float> dx(kBatch), dy(kBatch), dz(kBatch);
+  std::vector<uint64_t> masks(kBatch*nWords);
+  std::vector<float> posX, posY, posZ;
+  if(positions)
+    {
+      posX.resize(kBatch*nSlabs);
+      posY.resize(kBatch*nSlabs);
+      posZ.resize(kBatch*nSlabs);
+    }
+
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  double cosCone = std::cos(cone);
+  std::map<unsigned int, long> layerCounts;
+  double seconds = 0.;
+
+  for(long done=0; done<nRays; done+=kBatch)
+    {
+      long n = std::min(kBatch, nRays - done);
+      for(long r=0; r<n; r++)
+	{
+	  double cosTheta = 1. - uniform(rng)*(1. - cosCone);
+	  double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+	  double phi = 2*M_PI*uniform(rng);
+	  double a = sinTheta*std::cos(phi), b = sinTheta*std::sin(phi);
+	  dx[r] = a*u[0] + b*v[0] + cosTheta*w[0];
+	  dy[r] = a*u[1] + b*v[1] + cosTheta*w[1];
+	  dz[r] = a*u[2] + b*v[2] + cosTheta*w[2];
+	}
+
+      B1AcceptanceEngine::Rays rays = { x.data(), y.data(), z.data(),
+					dx.data(), dy.data(), dz.data(), std::size_t(n) };
+      auto start = std::chrono::steady_clock::now();
+      if(theta0 > 0.)
+	engine.PropagateScattered(rays, theta0, rng, masks.data(),
+				  positions ? posX.data() : nullptr,
+				  positions ? posY.data() : nullptr,
+				  positions ? posZ.data() : nullptr);
+      else
+	engine.Propagate(rays, masks.data(),
+			 positions ? posX.data() : nullptr,
+			 positions ? posY.data() : nullptr,
+			 positions ? posZ.data() : nullptr);
+      seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      for(long r=0; r<n; r++)
+	layerCounts[B1AcceptanceEngine::CountLayers(&masks[r*nWords], nWords)]++;
+    }
+
+  std::cout << "Acceptance engine: " << nSlabs << " gas layers, " << nRays << " "
+	    << (theta0 > 0. ? "scattered" : "straight") << " rays in " << seconds << " s, "
+	    << nRays/seconds/1e6 << " Mrays/s" << std::endl;
+
+  // Same format as macros/layers, the LayerCount of the Geant4 output
+  std::cout << "LayerCount distribution" << std::endl;
+  for(const auto& count : layerCounts)
+    std::cout << count.first << " " << count.second << std::endl;
+
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
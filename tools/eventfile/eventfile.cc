@@ -0,0 +1,283 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file eventfile.cc
+/// \brief Converter and read benchmark of B1EventFile
+
+#include "B1EventFile.hh"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+  void Usage()
+  {
+    std::cerr
+      << "Usage: eventfile [options]\n"
+      << "  -c in out       convert a HepMC3 ASCII (or B1EventFile) file to a B1EventFile\n"
+      << "  -g n file       write n synthetic HepMC3 ASCII events, for the benchmark\n"
+      << "  -b file         read all the events of a file with several threads\n"
+      << "  -t threads      threads of the benchmark (default 1 to the hardware threads)\n"
+      << "  -k chunk        events claimed at a time (default 64)\n"
+      << "  -seed n         random seed\n";
+  }
+
+  // Events with a decay vertex in the detector and a few hadrons at the
+  // interaction point, written as by the HepMC3 WriterAscii
+  bool Generate(long nEvents, const std::string& fileName, unsigned int seed)
+  {
+    std::ofstream file(fileName.c_str());
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(-1., 1.);
+    std::exponential_distribution<double> energy(0.2);
+    file << "HepMC::Version 3.01.01\n"
+	 << "HepMC::Asciiv3-START_EVENT_LISTING\n";
+    char line[256];
+    for(long e=0; e<nEvents; e++)
+      {
+	int nHadrons = 10 + int(10*(uniform(rng) + 1.));
+	file << "E " << e << " 2 " << nHadrons + 4 << "\n"
+	     << "U GEV MM\n"
+	     << "W 1\n"
+	     << "P 1 0 2212 0 0 7000 7000 0.938 4\n"
+	     << "P 2 0 2212 0 0 -7000 7000 0.938 4\n"
+	     << "V -1 0 [1,2]\n";
+	for(int h=0; h<nHadrons; h++)
+	  {
+	    std::snprintf(line, sizeof(line), "P %d -1 %d %.8e %.8e %.8e %.8e %.8e 1\n",
+			  3 + h, (h % 2) ? 211 : -211, energy(rng)*uniform(rng),
+			  energy(rng)*uniform(rng), 2*energy(rng), 10., 0.1396);
+	    file << line;
+	  }
+	int parent = 3 + nHadrons;
+	std::snprintf(line, sizeof(line), "P %d -1 9000001 0 0 50 51 10 2\n", parent);
+	file << line;
+	std::snprintf(line, sizeof(line), "V -2 0 [%d] @ %.6e %.6e %.6e %.6e\n", parent,
+		      5000*uniform(rng), 5000*uniform(rng), 25000 + 5000*uniform(rng), 30000.);
+	file << line;
+	for(int d=0; d<2; d++)
+	  {
+	    std::snprintf(line, sizeof(line), "P %d -2 %d %.8e %.8e %.8e %.8e 0.1057 1\n",
+			  parent + 1 + d, d ? 13 : -13, 2*uniform(rng), 2*uniform(rng),
+			  25. + 5*uniform(rng), 30.);
+	    file << line;
+	  }
+      }
+    file << "HepMC::Asciiv3-END_EVENT_LISTING\n";
+    return bool(file);
+  }
+
+  bool Convert(const std::string& in, const std::string& out)
+  {
+    B1EventFile input;
+    std::string error;
+    if(!input.Open(in, error))
+      {
+	std::cerr << error << std::endl;
+	return false;
+      }
+    std::vector<uint32_t> numbers;
+    std::vector<size_t> offsets(1, 0);
+    std::vector<B1EventFile::Particle> particles, event;
+    for(size_t e=0; e<input.NofEvents(); e++)
+      {
+	uint32_t number = 0;
+	if(!input.Read(e, event, number))
+	  {
+	    std::cerr << in << ": cannot parse event " << e << std::endl;
+	    return false;
+	  }
+	numbers.push_back(number);
+	particles.insert(particles.end(), event.begin(), event.end());
+	offsets.push_back(particles.size());
+      }
+    if(!B1EventFile::Write(out, numbers, offsets, particles))
+      {
+	std::cerr << "Cannot write " << out << std::endl;
+	return false;
+      }
+
+    // Same particles read back
+    B1EventFile output;
+    if(!output.Open(out, error) || output.NofEvents() != numbers.size())
+      {
+	std::cerr << "Cannot read back " << out << std::endl;
+	return false;
+      }
+    std::vector<B1EventFile::Particle> converted;
+    for(size_t e=0; e<input.NofEvents(); e++)
+      {
+	uint32_t number = 0;
+	output.Read(e, converted, number);
+	if(number != numbers[e] || converted.size() != offsets[e + 1] - offsets[e]
+	   || !std::equal(converted.begin(), converted.end(), particles.begin() + offsets[e],
+			  [](const B1EventFile::Particle& a, const B1EventFile::Particle& b)
+			  { return a.pdg == b.pdg && std::equal(a.momentum, a.momentum + 3, b.momentum)
+			      && std::equal(a.position, a.position + 4, b.position); }))
+	  {
+	    std::cerr << out << ": event " << e << " differs from the input" << std::endl;
+	    return false;
+	  }
+      }
+    std::cout << "Converted " << numbers.size() << " events, " << particles.size()
+	      << " particles, from " << in << " to " << out << std::endl;
+    return true;
+  }
+
+  // Each thread claims chunks of events from the shared cursor and reads
+  // them, as the workers of the simulation do
+  void Benchmark(B1EventFile& file, unsigned int nThreads, size_t chunk)
+  {
+    file.Rewind();
+    std::vector<size_t> nParticles(nThreads, 0);
+    std::vector<size_t> nFailed(nThreads, 0);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for(unsigned int t=0; t<nThreads; t++)
+      threads.emplace_back([&, t]()
+	{
+	  std::vector<B1EventFile::Particle> particles;
+	  size_t begin, n;
+	  uint32_t number;
+	  while((n = file.Claim(chunk, begin)) > 0)
+	    for(size_t e=begin; e<begin + n; e++)
+	      {
+		if(file.Read(e, particles, number))
+		  nParticles[t] += particles.size();
+		else
+		  nFailed[t]++;
+	      }
+	});
+    for(auto& thread : threads)
+      thread.join();
+    double seconds
+      = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t particles = 0, failed = 0;
+    for(unsigned int t=0; t<nThreads; t++)
+      {
+	particles += nParticles[t];
+	failed += nFailed[t];
+      }
+    std::cout << "  " << nThreads << " threads: " << file.NofEvents()/seconds << " events/s, "
+	      << particles/seconds << " particles/s";
+    if(failed)
+      std::cout << ", " << failed << " events not parsed";
+    std::cout << std::endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  std::string benchmarkFile;
+  unsigned int nThreads = 0;
+  size_t chunk = 64;
+  unsigned int seed = 12345;
+  bool done = false;
+
+  for(int i=1; i<argc; i++)
+    {
+      std::string arg = argv[i];
+      int nValues = (arg == "-c" || arg == "-g") ? 2 : 1;
+      if(i + nValues >= argc)
+	{
+	  Usage();
+	  return 1;
+	}
+      if(arg == "-c")
+	{
+	  if(!Convert(argv[i + 1], argv[i + 2]))
+	    return 1;
+	  i += 2;
+	  done = true;
+	}
+      else if(arg == "-g")
+	{
+	  if(!Generate(std::atol(argv[i + 1]), argv[i + 2], seed))
+	    {
+	      std::cerr << "Cannot write " << argv[i + 2] << std::endl;
+	      return 1;
+	    }
+	  i += 2;
+	  done = true;
+	}
+      else if(arg == "-b")
+	benchmarkFile = argv[++i];
+      else if(arg == "-t")
+	nThreads = std::atoi(argv[++i]);
+      else if(arg == "-k")
+	chunk = std::atol(argv[++i]);
+      else if(arg == "-seed")
+	seed = std::atoi(argv[++i]);
+      else
+	{
+	  Usage();
+	  return 1;
+	}
+    }
+
+  if(benchmarkFile.empty())
+    {
+      if(!done)
+	Usage();
+      return done ? 0 : 1;
+    }
+
+  B1EventFile file;
+  std::string error;
+  auto start = std::chrono::steady_clock::now();
+  if(!file.Open(benchmarkFile, error))
+    {
+      std::cerr << error << std::endl;
+      return 1;
+    }
+  double seconds
+    = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "Event file " << benchmarkFile << ": " << file.NofEvents() << " "
+	    << (file.IsHepMC() ? "HepMC3 ASCII" : "binary") << " events, indexed in "
+	    << seconds << " s" << std::endl;
+
+  unsigned int maxThreads = nThreads ? nThreads : std::max(1u, std::thread::hardware_concurrency());
+  for(unsigned int n = nThreads ? nThreads : 1; n <= maxThreads; n *= 2)
+    Benchmark(file, n, chunk);
+
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
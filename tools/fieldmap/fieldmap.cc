@@ -0,0 +1,292 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file fieldmap.cc
+/// \brief Field map generator and query benchmark of B1FieldMap
+
+#include "B1FieldMap.hh"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+  void Usage()
+  {
+    std::cerr
+      << "Usage: fieldmap [options]\n"
+      << "  -w file         write the map to the file and benchmark it (default fieldmap.bin)\n"
+      << "  -r file         benchmark an existing map\n"
+      << "  -n nx ny nz     nodes of a written map (default 201 201 21)\n"
+      << "  -b x0 y0 z0 x1 y1 z1\n"
+      << "                  extent of a written map in mm (default -1000 -1000 -1 1000 1000 1)\n"
+      << "  -e field        nominal field along z in kV/cm (default -54)\n"
+      << "  -q queries      number of queries of each pattern (default 10000000)\n"
+      << "  -seed n         random seed\n";
+  }
+
+  // Nominal field, falling off over 20 mm at the edges of the map and
+  // distorted around spacers every 100 mm in x and y
+  void Field(const double pos[3], const double min[3], const double max[3],
+	     double nominal, float value[4])
+  {
+    double edge = 1.;
+    for(int i=0; i<2; i++)
+      {
+	double distance = std::min(pos[i] - min[i], max[i] - pos[i]);
+	edge *= 1. - std::exp(-distance/20.);
+      }
+    double dx = std::remainder(pos[0], 100.), dy = std::remainder(pos[1], 100.);
+    double spacer = std::exp(-(dx*dx + dy*dy)/(2*5.*5.));
+    value[0] = float(0.2*nominal*spacer*dx/5.);
+    value[1] = float(0.2*nominal*spacer*dy/5.);
+    value[2] = float(nominal*edge*(1. - 0.3*spacer));
+    value[3] = 0.f;
+  }
+
+  bool WriteMap(const std::string& fileName, const uint32_t nodes[3],
+		const double min[3], const double max[3], double nominal,
+		bool linear)
+  {
+    std::vector<float> values(4*size_t(nodes[0])*nodes[1]*nodes[2]);
+    size_t index = 0;
+    for(uint32_t k=0; k<nodes[2]; k++)
+      for(uint32_t j=0; j<nodes[1]; j++)
+	for(uint32_t i=0; i<nodes[0]; i++, index+=4)
+	  {
+	    double pos[3] = { min[0] + (max[0] - min[0])*i/(nodes[0] - 1),
+			      min[1] + (max[1] - min[1])*j/(nodes[1] - 1),
+			      min[2] + (max[2] - min[2])*k/(nodes[2] - 1) };
+	    if(linear)
+	      {
+		// Reproduced exactly by the interpolation, up to rounding
+		values[index] = float(i);
+		values[index+1] = float(j);
+		values[index+2] = float(nominal + k);
+		values[index+3] = 0.f;
+	      }
+	    else
+	      Field(pos, min, max, nominal, &values[index]);
+	  }
+    return B1FieldMap::Write(fileName, nodes, min, max, values.data());
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  std::string fileName = "fieldmap.bin";
+  bool write = true;
+  uint32_t nodes[3] = { 201, 201, 21 };
+  double min[3] = { -1000., -1000., -1. };
+  double max[3] = { 1000., 1000., 1. };
+  double nominal = -54.;
+  long nQueries = 10000000;
+  unsigned int seed = 12345;
+
+  for(int i=1; i<argc; i++)
+    {
+      std::string arg = argv[i];
+      int nValues = (arg == "-n") ? 3 : (arg == "-b" ? 6 : 1);
+      if(i + nValues >= argc)
+	{
+	  Usage();
+	  return 1;
+	}
+      if(arg == "-w" || arg == "-r")
+	{
+	  fileName = argv[++i];
+	  write = (arg == "-w");
+	}
+      else if(arg == "-n")
+	for(int j=0; j<3; j++)
+	  nodes[j] = std::atoi(argv[++i]);
+      else if(arg == "-b")
+	{
+	  for(int j=0; j<3; j++)
+	    min[j] = std::atof(argv[++i]);
+	  for(int j=0; j<3; j++)
+	    max[j] = std::atof(argv[++i]);
+	}
+      else if(arg == "-e")
+	nominal = std::atof(argv[++i]);
+      else if(arg == "-q")
+	nQueries = std::atol(argv[++i]);
+      else if(arg == "-seed")
+	seed = std::atoi(argv[++i]);
+      else
+	{
+	  Usage();
+	  return 1;
+	}
+    }
+
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::string error;
+
+  // The interpolation of a linear field is exact
+  {
+    const std::string linearName = fileName + ".linear";
+    const uint32_t linearNodes[3] = { 11, 7, 5 };
+    B1FieldMap map;
+    if(!WriteMap(linearName, linearNodes, min, max, nominal, true)
+       || !map.Open(linearName, error))
+      {
+	std::cerr << "Cannot check the interpolation: " << error << std::endl;
+	return 1;
+      }
+    B1FieldMap::Cache cache;
+    double worst = 0.;
+    for(int q=0; q<100000; q++)
+      {
+	double pos[3], field[3];
+	for(int i=0; i<3; i++)
+	  pos[i] = min[i] + (max[i] - min[i])*uniform(rng);
+	map.Evaluate(pos, field, cache);
+	for(int i=0; i<3; i++)
+	  {
+	    double expected = (pos[i] - min[i])/(max[i] - min[i])*(linearNodes[i] - 1)
+	      + (i == 2 ? nominal : 0.);
+	    worst = std::max(worst, std::fabs(field[i] - expected));
+	  }
+      }
+    map.Close();
+    std::remove(linearName.c_str());
+    std::cout << "Linear field: maximum interpolation error " << worst << std::endl;
+    if(worst > 1e-4)
+      return 1;
+  }
+
+  if(write && !WriteMap(fileName, nodes, min, max, nominal, false))
+    {
+      std::cerr << "Cannot write the field map " << fileName << std::endl;
+      return 1;
+    }
+  B1FieldMap map;
+  if(!map.Open(fileName, error))
+    {
+      std::cerr << error << std::endl;
+      return 1;
+    }
+  const B1FieldMap::Header& header = map.GetHeader();
+  for(int i=0; i<3; i++)
+    {
+      nodes[i] = header.nodes[i];
+      min[i] = header.min[i];
+      max[i] = header.max[i];
+    }
+  std::cout << "Field map " << fileName << ": " << nodes[0] << " x " << nodes[1]
+	    << " x " << nodes[2] << " nodes" << std::endl;
+
+  // Positions are generated before the timing: uniform in the map, and
+  // Runge-Kutta-like walks, 4 queries per 0.2 mm step of a drifting track
+  std::vector<double> randomPos(3*nQueries), walkPos(3*nQueries);
+  for(long q=0; q<nQueries; q++)
+    for(int i=0; i<3; i++)
+      randomPos[3*q+i] = min[i] + (max[i] - min[i])*uniform(rng);
+  {
+    double pos[3] = { 0., 0., 0. }, dir[3] = { 0., 0., 0. };
+    const double kStep = 0.2;
+    const double kStages[4] = { 0., 0.5, 0.5, 1. };
+    for(long q=0; q<nQueries; q++)
+      {
+	int stage = q % 4;
+	if(q % 4000 == 0)
+	  {
+	    // New track, at the start of a step
+	    for(int i=0; i<3; i++)
+	      pos[i] = min[i] + (max[i] - min[i])*uniform(rng);
+	    double cosTheta = 2*uniform(rng) - 1., phi = 2*M_PI*uniform(rng);
+	    double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+	    dir[0] = sinTheta*std::cos(phi);
+	    dir[1] = sinTheta*std::sin(phi);
+	    dir[2] = cosTheta;
+	  }
+	else if(stage == 0)
+	  for(int i=0; i<3; i++)
+	    {
+	      pos[i] += kStep*dir[i];
+	      // Reflected at the faces of the map
+	      if(pos[i] < min[i] || pos[i] > max[i])
+		{
+		  pos[i] = 2*(pos[i] < min[i] ? min[i] : max[i]) - pos[i];
+		  dir[i] = -dir[i];
+		}
+	    }
+	for(int i=0; i<3; i++)
+	  {
+	    double x = pos[i] + kStages[stage]*kStep*dir[i];
+	    if(x < min[i] || x > max[i])
+	      x = 2*(x < min[i] ? min[i] : max[i]) - x;
+	    walkPos[3*q+i] = x;
+	  }
+      }
+  }
+
+  const char* names[3] = { "random", "walk", "walk, no cache" };
+  const std::vector<double>* positions[3] = { &randomPos, &walkPos, &walkPos };
+  for(int pattern=0; pattern<3; pattern++)
+    {
+      B1FieldMap::Cache cache;
+      const double* pos = positions[pattern]->data();
+      double sum = 0.;
+      long misses = 0, outside = 0;
+      auto start = std::chrono::steady_clock::now();
+      for(long q=0; q<nQueries; q++)
+	{
+	  double field[3];
+	  long cell = cache.cell;
+	  if(pattern == 2)
+	    cache.cell = -1;
+	  if(!map.Evaluate(pos + 3*q, field, cache))
+	    outside++;
+	  misses += (cache.cell != cell);
+	  sum += field[2];
+	}
+      double seconds
+	= std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      std::cout << "  " << names[pattern] << ": " << nQueries/seconds/1e6 << " Mqueries/s";
+      if(pattern != 2)
+	std::cout << ", " << 100.*(nQueries - misses)/nQueries << "% cache hits";
+      if(outside)
+	std::cout << ", " << outside << " outside";
+      // The sum keeps the queries from being optimised away
+      std::cout << " (mean Ez " << sum/nQueries << " kV/cm)" << std::endl;
+    }
+
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -49,6 +49,7 @@
 #include "Randomize.hh"
 
 #include "G4StepLimiterPhysics.hh"
+#include "G4FastSimulationPhysics.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -84,10 +85,18 @@ int main(int argc,char** argv)
   
   //G4VModularPhysicsList* physicsList = new QBBC;
 
-  // Step limiter
+  // Step limiter, for charged particles only, with the limits of the
+  // detector regions (/rpc/region/stepLimit)
   G4StepLimiterPhysics* stepLim = new G4StepLimiterPhysics();
-  stepLim->SetApplyToAll(true);
   physicsList->RegisterPhysics(stepLim);
+
+  // Fast simulation of the gas gap (B1GasFastSimModel) for charged particles
+  G4FastSimulationPhysics* fastSimPhysics = new G4FastSimulationPhysics();
+  const char* fastParticles[] = { "e-", "e+", "mu-", "mu+", "pi-", "pi+",
+				  "kaon-", "kaon+", "proton", "anti_proton" };
+  for(auto particle : fastParticles)
+    fastSimPhysics->ActivateFastSimulation(particle);
+  physicsList->RegisterPhysics(fastSimPhysics);
   
   physicsList->SetVerboseLevel(1);
   runManager->SetUserInitialization(physicsList);